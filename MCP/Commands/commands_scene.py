@@ -4,6 +4,7 @@ This module contains all scene-related commands for the UnrealArchitect bridge,
 including getting scene information, creating, modifying, and deleting objects.
 """
 
+import json
 import sys
 import os
 from mcp.server.fastmcp import Context
@@ -90,4 +91,27 @@ def register_all(mcp):
             else:
                 return f"Error: {response['message']}"
         except Exception as e:
-            return f"Error deleting object: {str(e)}" 
\ No newline at end of file
+            return f"Error deleting object: {str(e)}"
+
+    @mcp.tool()
+    def batch(ctx: Context, commands: list, stop_on_error: bool = False, transaction: bool = True) -> str:
+        """Execute many commands in a single round trip.
+        
+        Args:
+            commands: List of {"type": ..., "params": {...}} entries, e.g. several create_object calls
+            stop_on_error: Stop at the first sub-command that fails
+            transaction: Group all changes into a single undo step
+        """
+        try:
+            params = {
+                "commands": commands,
+                "stop_on_error": stop_on_error,
+                "transaction": transaction
+            }
+            response = send_command("batch", params)
+            if response["status"] == "success":
+                return json.dumps(response["result"], indent=2)
+            else:
+                return f"Error: {response['message']}"
+        except Exception as e:
+            return f"Error executing batch: {str(e)}"
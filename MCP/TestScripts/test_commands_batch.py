@@ -0,0 +1,78 @@
+"""Test script for the UnrealArchitect batch command.
+
+This script tests executing several commands in one dispatch through the batch command.
+Make sure Unreal Engine is running with the UnrealArchitect plugin enabled before running this script.
+"""
+
+import sys
+import os
+import json
+
+# Add the MCP directory to sys.path so we can import unreal_mcp_bridge
+mcp_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+if mcp_dir not in sys.path:
+    sys.path.insert(0, mcp_dir)
+
+from unreal_mcp_bridge import send_command
+
+def test_batch_create():
+    """Test creating several objects in one batch."""
+    print("\n1. Testing batch create_object...")
+    try:
+        commands = [
+            {"type": "create_object", "params": {"type": "cube", "location": [i * 200, 0, 100], "label": f"BatchCube_{i}"}}
+            for i in range(5)
+        ]
+        response = send_command("batch", {"commands": commands, "transaction": True})
+        print(f"Batch Response: {json.dumps(response, indent=2)}")
+        return response["status"] == "success" and response["result"]["succeeded"] == len(commands)
+    except Exception as e:
+        print(f"Error testing batch create_object: {e}")
+        return False
+
+def test_batch_stop_on_error():
+    """Test that stop_on_error skips the remaining sub-commands."""
+    print("\n2. Testing batch stop_on_error...")
+    try:
+        commands = [
+            {"type": "delete_object", "params": {"name": "DoesNotExist_MCPBatchTest"}},
+            {"type": "get_scene_info"}
+        ]
+        response = send_command("batch", {"commands": commands, "stop_on_error": True})
+        print(f"Batch Response: {json.dumps(response, indent=2)}")
+        result = response["result"]
+        return result["stopped"] and result["failed"] == 1 and result["skipped"] == 1
+    except Exception as e:
+        print(f"Error testing batch stop_on_error: {e}")
+        return False
+
+def main():
+    """Run all batch command tests."""
+    print("Starting UnrealArchitect batch command tests...")
+    print("Make sure Unreal Engine is running with the UnrealArchitect plugin enabled!")
+    
+    try:
+        results = {
+            "batch_create": test_batch_create(),
+            "batch_stop_on_error": test_batch_stop_on_error()
+        }
+        
+        print("\nTest Results:")
+        print("-" * 40)
+        for test_name, success in results.items():
+            status = "✓ PASS" if success else "✗ FAIL"
+            print(f"{status} - {test_name}")
+        print("-" * 40)
+        
+        if all(results.values()):
+            print("\nAll batch tests passed successfully!")
+        else:
+            print("\nSome tests failed. Check the output above for details.")
+            sys.exit(1)
+            
+    except Exception as e:
+        print(f"\nError during testing: {e}")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
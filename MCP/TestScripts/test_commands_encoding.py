@@ -0,0 +1,90 @@
+"""Test script for the UnrealArchitect wire protocol options.
+
+This script tests negotiating CBOR on a persistent connection, sending commands with it, and streamed results.
+Make sure Unreal Engine is running with the UnrealArchitect plugin enabled before running this script.
+"""
+
+import sys
+import os
+import json
+
+# Add the MCP directory to sys.path so we can import the utils package
+mcp_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+if mcp_dir not in sys.path:
+    sys.path.insert(0, mcp_dir)
+
+from utils.command_utils import MCPConnection
+
+def test_negotiate_cbor():
+    """Test that the server agrees to CBOR."""
+    print("\n1. Testing negotiate_encoding...")
+    try:
+        with MCPConnection(encoding="cbor") as connection:
+            print(f"Negotiated encoding: {connection.encoding}")
+            return connection.encoding == "cbor"
+    except Exception as e:
+        print(f"Error testing negotiate_encoding: {e}")
+        return False
+
+def test_cbor_commands():
+    """Test sending bulk transform commands as CBOR."""
+    print("\n2. Testing CBOR create_object and get_scene_info...")
+    try:
+        with MCPConnection(encoding="cbor") as connection:
+            responses = connection.send_commands([
+                ("create_object", {"type": "cube", "location": [i * 150.5, 0.25, 100.0], "label": f"CborCube_{i}"})
+                for i in range(5)
+            ])
+            scene = connection.send_command("get_scene_info")
+            print(f"Scene Response: {json.dumps(scene, indent=2)[:500]}")
+            return all(r["status"] == "success" for r in responses) and scene["status"] == "success"
+    except Exception as e:
+        print(f"Error testing CBOR commands: {e}")
+        return False
+
+def test_streamed_scene_info():
+    """Test receiving get_scene_info as a stream of actor chunks."""
+    print("\n3. Testing streamed get_scene_info...")
+    try:
+        with MCPConnection() as connection:
+            frames = list(connection.stream_command("get_scene_info", {"chunk_size": 100}))
+            header, trailer = frames[0], frames[-1]
+            actors = sum(len(frame["result"]["actors"]) for frame in frames if frame.get("stream") == "chunk")
+            print(f"Received {len(frames)} frames, {actors} of {header['result']['actor_count']} actors")
+            return (header.get("stream") == "begin" and trailer.get("stream") == "end"
+                    and trailer["status"] == "success" and actors == trailer["result"]["returned_actor_count"])
+    except Exception as e:
+        print(f"Error testing streamed get_scene_info: {e}")
+        return False
+
+def main():
+    """Run all wire protocol tests."""
+    print("Starting UnrealArchitect wire protocol tests...")
+    print("Make sure Unreal Engine is running with the UnrealArchitect plugin enabled!")
+    
+    try:
+        results = {
+            "negotiate_cbor": test_negotiate_cbor(),
+            "cbor_commands": test_cbor_commands(),
+            "streamed_scene_info": test_streamed_scene_info()
+        }
+        
+        print("\nTest Results:")
+        print("-" * 40)
+        for test_name, success in results.items():
+            status = "✓ PASS" if success else "✗ FAIL"
+            print(f"{status} - {test_name}")
+        print("-" * 40)
+        
+        if all(results.values()):
+            print("\nAll wire protocol tests passed successfully!")
+        else:
+            print("\nSome tests failed. Check the output above for details.")
+            sys.exit(1)
+            
+    except Exception as e:
+        print(f"\nError during testing: {e}")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
@@ -62,6 +62,22 @@ if env_port:
     except ValueError:
         print(f"Invalid MCP_PORT environment variable: {env_port}", file=sys.stderr)
 
+# Same-host clients can use the server's Unix domain socket (UnixSocketPath in the plugin settings) instead of TCP
+UNIX_SOCKET_PATH = os.environ.get("MCP_UNIX_SOCKET")
+
+def connect_to_server(port=DEFAULT_PORT, timeout=DEFAULT_TIMEOUT):
+    """Open a socket to the C++ MCP server, preferring the Unix domain socket when configured."""
+    if UNIX_SOCKET_PATH and hasattr(socket, "AF_UNIX"):
+        s = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        s.settimeout(timeout)
+        try:
+            s.connect(UNIX_SOCKET_PATH)
+        except OSError:
+            s.close()
+            raise
+        return s
+    return socket.create_connection(("localhost", port), timeout=timeout)
+
 print(f"Using port: {DEFAULT_PORT}", file=sys.stderr)
 print(f"Using buffer size: {DEFAULT_BUFFER_SIZE}", file=sys.stderr)
 
@@ -109,9 +125,7 @@ def send_command(command_type, params=None, timeout=DEFAULT_TIMEOUT, port=DEFAUL
         The JSON response from the server
     """
     try:
-        with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as s:
-            s.settimeout(timeout)  # Set a timeout
-            s.connect(("localhost", port))  # Connect to Unreal C++ server
+        with connect_to_server(port, timeout) as s:  # Connect to Unreal C++ server
             command = {
                 "type": command_type,
                 "params": params or {}
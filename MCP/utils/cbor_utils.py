@@ -0,0 +1,163 @@
+"""Minimal CBOR (RFC 8949) encoder and decoder for the MCP wire protocol.
+
+Covers the JSON data model only (maps with string keys, arrays, strings, numbers,
+booleans and null), which is all the C++ server exchanges, so no third-party
+package is needed.
+"""
+
+import struct
+
+
+def dumps(value):
+    """Encode a JSON-compatible value as CBOR bytes."""
+    out = bytearray()
+    _encode(value, out)
+    return bytes(out)
+
+
+def loads(data):
+    """Decode CBOR bytes into Python values."""
+    value, offset = _decode(memoryview(data), 0)
+    if offset != len(data):
+        raise ValueError("Trailing data after CBOR item")
+    return value
+
+
+def _encode_header(major, argument, out):
+    major <<= 5
+    if argument < 24:
+        out.append(major | argument)
+    elif argument <= 0xFF:
+        out.append(major | 24)
+        out.append(argument)
+    elif argument <= 0xFFFF:
+        out.append(major | 25)
+        out += struct.pack(">H", argument)
+    elif argument <= 0xFFFFFFFF:
+        out.append(major | 26)
+        out += struct.pack(">I", argument)
+    else:
+        out.append(major | 27)
+        out += struct.pack(">Q", argument)
+
+
+def _encode(value, out):
+    if value is None:
+        out.append(0xF6)
+    elif value is True:
+        out.append(0xF5)
+    elif value is False:
+        out.append(0xF4)
+    elif isinstance(value, int):
+        if value >= 0:
+            _encode_header(0, value, out)
+        else:
+            _encode_header(1, -1 - value, out)
+    elif isinstance(value, float):
+        # Single precision is enough for most transforms and halves their size
+        try:
+            single = struct.pack(">f", value)
+        except OverflowError:
+            single = None
+        if single is not None and struct.unpack(">f", single)[0] == value:
+            out.append(0xFA)
+            out += single
+        else:
+            out.append(0xFB)
+            out += struct.pack(">d", value)
+    elif isinstance(value, str):
+        encoded = value.encode('utf-8')
+        _encode_header(3, len(encoded), out)
+        out += encoded
+    elif isinstance(value, (bytes, bytearray)):
+        _encode_header(2, len(value), out)
+        out += value
+    elif isinstance(value, (list, tuple)):
+        _encode_header(4, len(value), out)
+        for element in value:
+            _encode(element, out)
+    elif isinstance(value, dict):
+        _encode_header(5, len(value), out)
+        for key, element in value.items():
+            _encode(str(key), out)
+            _encode(element, out)
+    else:
+        raise TypeError(f"Cannot encode {type(value).__name__} as CBOR")
+
+
+def _decode_argument(data, info, offset):
+    if info < 24:
+        return info, offset
+    sizes = {24: (1, ">B"), 25: (2, ">H"), 26: (4, ">I"), 27: (8, ">Q")}
+    if info not in sizes:
+        raise ValueError(f"Invalid CBOR additional information {info}")
+    size, fmt = sizes[info]
+    return struct.unpack(fmt, data[offset:offset + size])[0], offset + size
+
+
+def _decode_half(bits):
+    exponent = (bits >> 10) & 0x1F
+    mantissa = bits & 0x3FF
+    if exponent == 0:
+        value = mantissa * 2.0 ** -24
+    elif exponent != 31:
+        value = (mantissa + 1024) * 2.0 ** (exponent - 25)
+    else:
+        value = float('inf') if mantissa == 0 else float('nan')
+    return -value if bits & 0x8000 else value
+
+
+def _decode(data, offset):
+    initial = data[offset]
+    offset += 1
+    major, info = initial >> 5, initial & 0x1F
+
+    if major == 7:
+        if info == 20:
+            return False, offset
+        if info == 21:
+            return True, offset
+        if info in (22, 23):
+            return None, offset
+        if info == 25:
+            return _decode_half(struct.unpack(">H", data[offset:offset + 2])[0]), offset + 2
+        if info == 26:
+            return struct.unpack(">f", data[offset:offset + 4])[0], offset + 4
+        if info == 27:
+            return struct.unpack(">d", data[offset:offset + 8])[0], offset + 8
+        raise ValueError(f"Unsupported CBOR simple value {info}")
+
+    if info == 31 and major in (4, 5):
+        items = []
+        while data[offset] != 0xFF:
+            item, offset = _decode(data, offset)
+            items.append(item)
+        offset += 1
+        if major == 4:
+            return items, offset
+        return dict(zip(items[0::2], items[1::2])), offset
+
+    argument, offset = _decode_argument(data, info, offset)
+
+    if major == 0:
+        return argument, offset
+    if major == 1:
+        return -1 - argument, offset
+    if major == 2:
+        return bytes(data[offset:offset + argument]), offset + argument
+    if major == 3:
+        return bytes(data[offset:offset + argument]).decode('utf-8'), offset + argument
+    if major == 4:
+        items = []
+        for _ in range(argument):
+            item, offset = _decode(data, offset)
+            items.append(item)
+        return items, offset
+    if major == 5:
+        result = {}
+        for _ in range(argument):
+            key, offset = _decode(data, offset)
+            result[key], offset = _decode(data, offset)
+        return result, offset
+    # Tags have no meaning here; decode the tagged item
+    return _decode(data, offset)
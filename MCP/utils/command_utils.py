@@ -1,13 +1,19 @@
 """Utility functions for MCP commands."""
 
 import json
+import mmap
 import socket
+import struct
 import sys
+import zlib
+
+from utils import cbor_utils
 
 # Constants (these will be read from MCPConstants.h)
 DEFAULT_PORT = 13377
 DEFAULT_BUFFER_SIZE = 65536
 DEFAULT_TIMEOUT = 10
+FRAME_COMPRESSED_FLAG = 0x80000000
 
 try:
     # Try to read the port from the C++ constants
@@ -41,12 +47,26 @@ if env_port:
     except ValueError:
         print(f"Invalid MCP_PORT environment variable: {env_port}", file=sys.stderr)
 
+# Same-host clients can use the server's Unix domain socket (UnixSocketPath in the plugin settings) instead of TCP
+UNIX_SOCKET_PATH = os.environ.get("MCP_UNIX_SOCKET")
+
+def connect_to_server(port=DEFAULT_PORT, timeout=DEFAULT_TIMEOUT):
+    """Open a socket to the C++ MCP server, preferring the Unix domain socket when configured."""
+    if UNIX_SOCKET_PATH and hasattr(socket, "AF_UNIX"):
+        s = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        s.settimeout(timeout)
+        try:
+            s.connect(UNIX_SOCKET_PATH)
+        except OSError:
+            s.close()
+            raise
+        return s
+    return socket.create_connection(("localhost", port), timeout=timeout)
+
 def send_command(command_type, params=None, port=DEFAULT_PORT):
     """Send a command to the C++ MCP server and return the response."""
     try:
-        with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as s:
-            s.settimeout(DEFAULT_TIMEOUT)
-            s.connect(("localhost", port))
+        with connect_to_server(port) as s:
             command = {
                 "type": command_type,
                 "params": params or {}
@@ -87,4 +107,207 @@ def send_command(command_type, params=None, port=DEFAULT_PORT):
         raise Exception("Failed to communicate with Unreal MCP server: Connection timed out")
     except Exception as e:
         print(f"Error communicating with Unreal MCP server: {str(e)}", file=sys.stderr)
-        raise Exception(f"Failed to communicate with Unreal MCP server: {str(e)}") 
\ No newline at end of file
+        raise Exception(f"Failed to communicate with Unreal MCP server: {str(e)}") 
+
+class MCPConnection:
+    """Persistent connection to the C++ MCP server that pipelines requests.
+
+    Every request is tagged with an "id" that the server echoes in its response,
+    so many commands can be sent back to back without waiting for each reply.
+
+    With encoding="cbor" the connection uses length-prefixed framing and, once the
+    server has agreed via negotiate_encoding, sends and receives CBOR, which is
+    considerably smaller and faster to parse for numeric-heavy payloads.
+    With compress=True large responses arrive zlib-compressed.
+    """
+
+    def __init__(self, host="localhost", port=DEFAULT_PORT, timeout=DEFAULT_TIMEOUT, encoding="json", compress=False):
+        if host == "localhost":
+            self._sock = connect_to_server(port, timeout)
+        else:
+            self._sock = socket.create_connection((host, port), timeout=timeout)
+        self._reader = self._sock.makefile('rb')
+        self._next_id = 1
+        self._length_prefixed = encoding != "json" or compress
+        self.encoding = "json"
+        self.compression = None
+
+        if self._length_prefixed:
+            params = {"encodings": [encoding, "json"]}
+            if compress:
+                params["compression"] = ["zlib"]
+            response = self.send_command("negotiate_encoding", params)
+            if response.get("status") == "success":
+                self.encoding = response["result"]["encoding"]
+                self.compression = response["result"].get("compression")
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+    def close(self):
+        """Close the connection."""
+        self._reader.close()
+        self._sock.close()
+
+    def _encode(self, message):
+        if self.encoding == "cbor":
+            return cbor_utils.dumps(message)
+        return json.dumps(message).encode('utf-8')
+
+    def _decode(self, payload):
+        # Responses mirror the encoding of their request, which a CBOR map header identifies
+        if payload and payload[0] >> 5 == 5:
+            return cbor_utils.loads(payload)
+        return json.loads(payload.decode('utf-8'))
+
+    def _read_exact(self, size):
+        data = self._reader.read(size)
+        if len(data) < size:
+            raise Exception("Connection closed by Unreal MCP server")
+        return data
+
+    def _read_message(self):
+        if self._length_prefixed:
+            header = struct.unpack(">I", self._read_exact(4))[0]
+            payload = self._read_exact(header & ~FRAME_COMPRESSED_FLAG)
+            if header & FRAME_COMPRESSED_FLAG:
+                # Compressed payloads start with their uncompressed size
+                uncompressed_size = struct.unpack(">I", payload[:4])[0]
+                payload = zlib.decompress(payload[4:], bufsize=uncompressed_size)
+            return self._decode(payload)
+
+        # Newline-delimited JSON responses
+        while True:
+            line = self._reader.readline()
+            if not line:
+                raise Exception("Connection closed by Unreal MCP server")
+            if line.strip():
+                return json.loads(line.decode('utf-8'))
+
+    def send_commands(self, commands):
+        """Send several (command_type, params) pairs at once and return their responses in order."""
+        request_ids = []
+        frames = []
+        for command_type, params in commands:
+            request_id = self._next_id
+            self._next_id += 1
+            request_ids.append(request_id)
+            payload = self._encode({"id": request_id, "type": command_type, "params": params or {}})
+            if self._length_prefixed:
+                frames.append(struct.pack(">I", len(payload)) + payload)
+            else:
+                frames.append(payload + b"\n")
+
+        self._sock.sendall(b"".join(frames))
+
+        # Responses may arrive in any order
+        responses = {}
+        while len(responses) < len(request_ids):
+            response = self._read_message()
+            responses[response.get("id")] = response
+
+        return [responses[request_id] for request_id in request_ids]
+
+    def send_command(self, command_type, params=None):
+        """Send a single command over the persistent connection."""
+        return self.send_commands([(command_type, params)])[0]
+
+    def stream_command(self, command_type, params=None):
+        """Send a command asking for a streamed result and yield each frame as it arrives.
+
+        Frames are the "begin" header, the "chunk" parts and the final "end" trailer. A
+        command that cannot stream answers with a single ordinary response instead.
+        Do not interleave with other requests on this connection while iterating.
+        """
+        request_id = self._next_id
+        self._next_id += 1
+        payload = self._encode({"id": request_id, "type": command_type, "params": params or {}, "stream": True})
+        if self._length_prefixed:
+            self._sock.sendall(struct.pack(">I", len(payload)) + payload)
+        else:
+            self._sock.sendall(payload + b"\n")
+
+        while True:
+            frame = self._read_message()
+            if frame.get("id") != request_id:
+                continue
+            yield frame
+            if frame.get("stream", "end") == "end":
+                return
+
+
+class SharedChannel:
+    """Shared memory ring buffer for sending bulk requests to a server on the same machine.
+
+    Requests are written once into shared memory and executed with shared_dispatch, so
+    their bytes never pass through a socket. Linux only.
+    """
+
+    # Magic, version, capacity, write offset, read offset; see FMCPSharedRingHeader
+    _HEADER = struct.Struct("<IIQqq")
+    _MAGIC = 0x5250434D
+    _WRITE_OFFSET_POSITION = 16
+    _READ_OFFSET_POSITION = 24
+
+    def __init__(self, connection, capacity=None):
+        response = connection.send_command("open_shared_channel", {} if capacity is None else {"capacity": capacity})
+        if response.get("status") != "success":
+            raise Exception(f"Failed to open shared channel: {response.get('message')}")
+
+        result = response["result"]
+        if "path" not in result:
+            raise Exception("Shared channels are only supported when the editor runs on Linux")
+
+        self._connection = connection
+        self.channel = result["channel"]
+        self.capacity = result["capacity"]
+        self._data_offset = result["data_offset"]
+        with open(result["path"], "r+b") as f:
+            self._map = mmap.mmap(f.fileno(), self._data_offset + self.capacity)
+
+        magic, _, _, self._write_offset, _ = self._HEADER.unpack_from(self._map, 0)
+        if magic != self._MAGIC:
+            raise Exception("Shared channel header is not initialised")
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+    def close(self):
+        """Unmap the channel and ask the server to release it."""
+        self._map.close()
+        self._connection.send_command("close_shared_channel", {"channel": self.channel})
+
+    def write(self, payload):
+        """Copy a payload into the ring and return its (offset, length) for shared_dispatch."""
+        length = len(payload)
+        if length > self.capacity:
+            raise ValueError(f"Payload of {length} bytes does not fit in a {self.capacity} byte channel")
+
+        # Payloads never wrap; skip the tail of the data area instead
+        offset = self._write_offset
+        start = offset % self.capacity
+        if start + length > self.capacity:
+            offset += self.capacity - start
+            start = 0
+
+        read_offset = struct.unpack_from("<q", self._map, self._READ_OFFSET_POSITION)[0]
+        if offset + length - read_offset > self.capacity:
+            raise Exception("Shared channel is full; wait for dispatched commands to complete")
+
+        position = self._data_offset + start
+        self._map[position:position + length] = payload
+        self._write_offset = offset + length
+        struct.pack_into("<q", self._map, self._WRITE_OFFSET_POSITION, self._write_offset)
+        return offset, length
+
+    def send_command(self, command_type, params=None):
+        """Write a command into shared memory and execute it."""
+        offset, length = self.write(cbor_utils.dumps({"type": command_type, "params": params or {}}))
+        return self._connection.send_command("shared_dispatch", {"channel": self.channel, "offset": offset, "length": length})
+
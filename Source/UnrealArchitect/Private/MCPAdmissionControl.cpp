@@ -0,0 +1,58 @@
+#include "MCPAdmissionControl.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+bool FMCPTokenBucket::TryConsume(double Cost, double Now, double& OutRetryAfterSeconds)
+{
+    OutRetryAfterSeconds = 0.0;
+    if (Rate <= 0.0)
+    {
+        return true;
+    }
+
+    Tokens = FMath::Min(Burst, Tokens + (Now - LastRefillTime) * Rate);
+    LastRefillTime = Now;
+
+    const double Needed = FMath::Min(Cost, Burst);
+    if (Tokens >= Needed)
+    {
+        Tokens -= Needed;
+        return true;
+    }
+
+    OutRetryAfterSeconds = (Needed - Tokens) / Rate;
+    return false;
+}
+
+FMCPClientAdmission::FMCPClientAdmission(double RatePerSecond, double Burst)
+    : InFlight(0)
+{
+    // Start full, so a new client is not throttled before it has done anything
+    Bucket.Rate = RatePerSecond;
+    Bucket.Burst = FMath::Max(Burst, 1.0);
+    Bucket.Tokens = Bucket.Burst;
+    Bucket.LastRefillTime = FPlatformTime::Seconds();
+}
+
+bool FMCPClientAdmission::TryBeginRequest(int32 MaxInFlight)
+{
+    // Only the I/O thread begins requests, so the check and increment cannot race each other
+    if (MaxInFlight > 0 && InFlight.load(std::memory_order_relaxed) >= MaxInFlight)
+    {
+        return false;
+    }
+
+    InFlight.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FMCPClientAdmission::EndRequest()
+{
+    InFlight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool FMCPClientAdmission::TryCharge(double Cost, double& OutRetryAfterSeconds)
+{
+    FScopeLock Lock(&BucketLock);
+    return Bucket.TryConsume(Cost, FPlatformTime::Seconds(), OutRetryAfterSeconds);
+}
@@ -0,0 +1,51 @@
+#include "MCPBufferPool.h"
+
+FMCPBufferPool::FMCPBufferPool(int64 InMaxPooledBytes)
+    : MaxPooledBytes(InMaxPooledBytes)
+    , PooledBytes(0)
+    , LentBytes(0)
+{
+}
+
+TArray<uint8> FMCPBufferPool::Acquire(int32 MinCapacity)
+{
+    const int32 Class = FMath::Max(MIN_CLASS, int32(FMath::CeilLogTwo(uint32(FMath::Max(MinCapacity, 1)))));
+
+    TArray<uint8> Buffer;
+    if (Class <= MAX_CLASS && FreeBuffers[Class - MIN_CLASS].Num() > 0)
+    {
+        Buffer = FreeBuffers[Class - MIN_CLASS].Pop(EAllowShrinking::No);
+        PooledBytes.fetch_sub(Buffer.Max(), std::memory_order_relaxed);
+    }
+    else
+    {
+        // Round up to the class size so the buffer can be pooled again when it comes back
+        Buffer.Reserve(Class <= MAX_CLASS ? (1 << Class) : MinCapacity);
+    }
+
+    LentBytes.fetch_add(Buffer.Max(), std::memory_order_relaxed);
+    return Buffer;
+}
+
+void FMCPBufferPool::Release(TArray<uint8>&& Buffer)
+{
+    const int32 Capacity = Buffer.Max();
+    if (Capacity == 0)
+    {
+        return;
+    }
+
+    LentBytes.fetch_sub(Capacity, std::memory_order_relaxed);
+
+    // File under the largest class the buffer fully covers
+    const int32 Class = int32(FMath::FloorLog2(uint32(Capacity)));
+    if (Class < MIN_CLASS || Class > MAX_CLASS || GetPooledBytes() + Capacity > MaxPooledBytes)
+    {
+        Buffer.Empty();
+        return;
+    }
+
+    Buffer.Reset();
+    PooledBytes.fetch_add(Capacity, std::memory_order_relaxed);
+    FreeBuffers[Class - MIN_CLASS].Add(MoveTemp(Buffer));
+}
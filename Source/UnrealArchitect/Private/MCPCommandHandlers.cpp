@@ -9,6 +9,9 @@
 #include "Misc/Paths.h"
 #include "Misc/Guid.h"
 #include "MCPConstants.h"
+#include "MCPResponseStream.h"
+#include "MCPJsonStructuralIndex.h"
+#include "Serialization/JsonSerializer.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Engine/Blueprint.h"
@@ -38,25 +41,10 @@ TSharedPtr<FJsonObject> FMCPGetSceneInfoHandler::Execute(const TSharedPtr<FJsonO
     }
 
     // Then collect actor info up to the limit
+    ActorsArray.Reserve(FMath::Min(TotalActorCount, MCPConstants::MAX_ACTORS_IN_SCENE_INFO));
     for (TActorIterator<AActor> It(World); It; ++It)
     {
-        AActor *Actor = *It;
-        TSharedPtr<FJsonObject> ActorInfo = MakeShared<FJsonObject>();
-        ActorInfo->SetStringField("name", Actor->GetName());
-        ActorInfo->SetStringField("type", Actor->GetClass()->GetName());
-
-        // Add the actor label (user-facing friendly name)
-        ActorInfo->SetStringField("label", Actor->GetActorLabel());
-
-        // Add location
-        FVector Location = Actor->GetActorLocation();
-        TArray<TSharedPtr<FJsonValue>> LocationArray;
-        LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
-        LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
-        LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
-        ActorInfo->SetArrayField("location", LocationArray);
-
-        ActorsArray.Add(MakeShared<FJsonValueObject>(ActorInfo));
+        ActorsArray.Add(MakeActorInfo(*It));
         ActorCount++;
         if (ActorCount >= MCPConstants::MAX_ACTORS_IN_SCENE_INFO)
         {
@@ -71,55 +59,151 @@ TSharedPtr<FJsonObject> FMCPGetSceneInfoHandler::Execute(const TSharedPtr<FJsonO
     Result->SetNumberField("actor_count", TotalActorCount);
     Result->SetNumberField("returned_actor_count", ActorCount);
     Result->SetBoolField("limit_reached", bLimitReached);
-    Result->SetArrayField("actors", ActorsArray);
+    Result->SetField("actors", MakeShared<FJsonValueArray>(MoveTemp(ActorsArray)));
 
     MCP_LOG_INFO("Sending get_scene_info response with %d/%d actors", ActorCount, TotalActorCount);
 
     return CreateSuccessResponse(Result);
 }
 
+namespace
+{
+    /**
+     * Streams the actors of a level one chunk per step
+     * The actors are listed up front, so actors spawned while streaming are not included and
+     * actors destroyed before their chunk is sent are skipped.
+     */
+    class FMCPSceneInfoStreamProducer : public IMCPStreamProducer
+    {
+    public:
+        FMCPSceneInfoStreamProducer(UWorld* World, int32 InChunkSize)
+            : ChunkSize(InChunkSize)
+            , NextIndex(0)
+            , ActorCount(0)
+        {
+            for (TActorIterator<AActor> It(World); It; ++It)
+            {
+                Actors.Add(*It);
+            }
+        }
+
+        int32 GetNumActors() const { return Actors.Num(); }
+
+        virtual void Step(FMCPResponseStream& Stream) override
+        {
+            // Only one chunk's worth of actor descriptions is alive at a time
+            TArray<TSharedPtr<FJsonValue>> ActorsArray;
+            ActorsArray.Reserve(ChunkSize);
+            while (NextIndex < Actors.Num() && ActorsArray.Num() < ChunkSize)
+            {
+                if (AActor* Actor = Actors[NextIndex++].Get())
+                {
+                    ActorsArray.Add(FMCPGetSceneInfoHandler::MakeActorInfo(Actor));
+                }
+            }
+
+            if (ActorsArray.Num() > 0)
+            {
+                ActorCount += ActorsArray.Num();
+                TSharedPtr<FJsonObject> Chunk = MakeShared<FJsonObject>();
+                Chunk->SetArrayField("actors", MoveTemp(ActorsArray));
+                Stream.SendChunk(Chunk);
+            }
+
+            if (NextIndex >= Actors.Num())
+            {
+                TSharedPtr<FJsonObject> Trailer = MakeShared<FJsonObject>();
+                Trailer->SetNumberField("returned_actor_count", ActorCount);
+                Stream.End(Trailer);
+
+                MCP_LOG_INFO("Streamed get_scene_info with %d actors in %d chunks", ActorCount, Stream.GetNumChunks());
+            }
+        }
+
+    private:
+        /** The level's actors when the stream began */
+        TArray<TWeakObjectPtr<AActor>> Actors;
+
+        /** Actors per chunk */
+        int32 ChunkSize;
+
+        /** Index of the next actor to describe */
+        int32 NextIndex;
+
+        /** Actors sent so far */
+        int32 ActorCount;
+    };
+}
+
+TSharedPtr<IMCPStreamProducer> FMCPGetSceneInfoHandler::BeginStreaming(const TSharedPtr<FJsonObject> &Params, FMCPResponseStream &Stream)
+{
+    MCP_LOG_INFO("Handling streamed get_scene_info command");
+
+    UWorld *World = GEditor->GetEditorWorldContext().World();
+
+    int32 ChunkSize = MCPConstants::DEFAULT_STREAM_CHUNK_SIZE;
+    Params->TryGetNumberField(FStringView(TEXT("chunk_size")), ChunkSize);
+    ChunkSize = FMath::Max(ChunkSize, 1);
+
+    TSharedPtr<FMCPSceneInfoStreamProducer> Producer = MakeShared<FMCPSceneInfoStreamProducer>(World, ChunkSize);
+
+    TSharedPtr<FJsonObject> Header = MakeShared<FJsonObject>();
+    Header->SetStringField("level", World->GetName());
+    Header->SetNumberField("actor_count", Producer->GetNumActors());
+    Stream.Begin(Header);
+
+    return Producer;
+}
+
+TSharedPtr<FJsonValue> FMCPGetSceneInfoHandler::MakeActorInfo(AActor *Actor)
+{
+    TSharedPtr<FJsonObject> ActorInfo = MakeShared<FJsonObject>();
+    ActorInfo->Values.Reserve(4);
+    MCPJsonKeys::Name.Set(*ActorInfo, MakeShared<FJsonValueString>(Actor->GetName()));
+    ActorInfo->SetStringField("type", Actor->GetClass()->GetName());
+
+    // Add the actor label (user-facing friendly name)
+    ActorInfo->SetStringField("label", Actor->GetActorLabel());
+
+    // Add location
+    FVector Location = Actor->GetActorLocation();
+    TArray<TSharedPtr<FJsonValue>> LocationArray;
+    LocationArray.Reserve(3);
+    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
+    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
+    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
+    MCPJsonKeys::Location.Set(*ActorInfo, MakeShared<FJsonValueArray>(MoveTemp(LocationArray)));
+
+    return MakeShared<FJsonValueObject>(ActorInfo);
+}
+
 //
 // FMCPCreateObjectHandler
 //
-TSharedPtr<FJsonObject> FMCPCreateObjectHandler::Execute(const TSharedPtr<FJsonObject> &Params, FSocket *ClientSocket)
+const TMCPParamSchema<FMCPCreateObjectParams>& FMCPCreateObjectParams::GetSchema()
 {
-    UWorld *World = GEditor->GetEditorWorldContext().World();
-
-    FString Type;
-    if (!Params->TryGetStringField(FStringView(TEXT("type")), Type))
-    {
-        MCP_LOG_WARNING("Missing 'type' field in create_object command");
-        return CreateErrorResponse("Missing 'type' field");
-    }
+    static const TMCPParamSchema<FMCPCreateObjectParams> Schema = TMCPParamSchema<FMCPCreateObjectParams>()
+        .Add(TEXT("type"), &FMCPCreateObjectParams::Type)
+        .Add(TEXT("location"), &FMCPCreateObjectParams::Location)
+        .Add(TEXT("mesh"), &FMCPCreateObjectParams::Mesh, EMCPParamPresence::Optional)
+        .Add(TEXT("label"), &FMCPCreateObjectParams::Label, EMCPParamPresence::Optional);
+    return Schema;
+}
 
-    // Get location
-    const TArray<TSharedPtr<FJsonValue>> *LocationArrayPtr = nullptr;
-    if (!Params->TryGetArrayField(FStringView(TEXT("location")), LocationArrayPtr) || !LocationArrayPtr || LocationArrayPtr->Num() != 3)
-    {
-        MCP_LOG_WARNING("Invalid 'location' field in create_object command");
-        return CreateErrorResponse("Invalid 'location' field");
-    }
+TSharedPtr<FJsonObject> FMCPCreateObjectHandler::ExecuteTyped(const FMCPCreateObjectParams &Params, FSocket *ClientSocket)
+{
+    UWorld *World = GEditor->GetEditorWorldContext().World();
 
-    FVector Location(
-        (*LocationArrayPtr)[0]->AsNumber(),
-        (*LocationArrayPtr)[1]->AsNumber(),
-        (*LocationArrayPtr)[2]->AsNumber());
+    const FString& Type = Params.Type;
+    const FVector& Location = Params.Location;
 
     // Convert type to lowercase for case-insensitive comparison
     FString TypeLower = Type.ToLower();
 
     if (Type == "StaticMeshActor")
     {
-        // Get mesh path if specified
-        FString MeshPath;
-        Params->TryGetStringField(FStringView(TEXT("mesh")), MeshPath);
-
-        // Get label if specified
-        FString Label;
-        Params->TryGetStringField(FStringView(TEXT("label")), Label);
-
         // Create the actor
-        TPair<AStaticMeshActor *, bool> Result = CreateStaticMeshActor(World, Location, MeshPath, Label);
+        TPair<AStaticMeshActor *, bool> Result = CreateStaticMeshActor(World, Location, Params.Mesh, Params.Label);
 
         if (Result.Value)
         {
@@ -136,9 +220,7 @@ TSharedPtr<FJsonObject> FMCPCreateObjectHandler::Execute(const TSharedPtr<FJsonO
     else if (TypeLower == "cube")
     {
         // Create a cube actor
-        FString Label;
-        Params->TryGetStringField(FStringView(TEXT("label")), Label);
-        TPair<AStaticMeshActor *, bool> Result = CreateCubeActor(World, Location, Label);
+        TPair<AStaticMeshActor *, bool> Result = CreateCubeActor(World, Location, Params.Label);
 
         if (Result.Value)
         {
@@ -265,16 +347,21 @@ TPair<AStaticMeshActor *, bool> FMCPCreateObjectHandler::CreateCubeActor(UWorld
 //
 // FMCPModifyObjectHandler
 //
-TSharedPtr<FJsonObject> FMCPModifyObjectHandler::Execute(const TSharedPtr<FJsonObject> &Params, FSocket *ClientSocket)
+const TMCPParamSchema<FMCPModifyObjectParams>& FMCPModifyObjectParams::GetSchema()
+{
+    static const TMCPParamSchema<FMCPModifyObjectParams> Schema = TMCPParamSchema<FMCPModifyObjectParams>()
+        .Add(TEXT("name"), &FMCPModifyObjectParams::Name)
+        .Add(TEXT("location"), &FMCPModifyObjectParams::Location)
+        .Add(TEXT("rotation"), &FMCPModifyObjectParams::Rotation)
+        .Add(TEXT("scale"), &FMCPModifyObjectParams::Scale);
+    return Schema;
+}
+
+TSharedPtr<FJsonObject> FMCPModifyObjectHandler::ExecuteTyped(const FMCPModifyObjectParams &Params, FSocket *ClientSocket)
 {
     UWorld *World = GEditor->GetEditorWorldContext().World();
 
-    FString ActorName;
-    if (!Params->TryGetStringField(FStringView(TEXT("name")), ActorName))
-    {
-        MCP_LOG_WARNING("Missing 'name' field in modify_object command");
-        return CreateErrorResponse("Missing 'name' field");
-    }
+    const FString& ActorName = Params.Name;
 
     AActor *Actor = nullptr;
     for (TActorIterator<AActor> It(World); It; ++It)
@@ -295,42 +382,27 @@ TSharedPtr<FJsonObject> FMCPModifyObjectHandler::Execute(const TSharedPtr<FJsonO
     bool bModified = false;
 
     // Check for location update
-    const TArray<TSharedPtr<FJsonValue>> *LocationArrayPtr = nullptr;
-    if (Params->TryGetArrayField(FStringView(TEXT("location")), LocationArrayPtr) && LocationArrayPtr && LocationArrayPtr->Num() == 3)
+    if (Params.Location.IsSet())
     {
-        FVector NewLocation(
-            (*LocationArrayPtr)[0]->AsNumber(),
-            (*LocationArrayPtr)[1]->AsNumber(),
-            (*LocationArrayPtr)[2]->AsNumber());
-
+        const FVector& NewLocation = Params.Location.GetValue();
         Actor->SetActorLocation(NewLocation);
         MCP_LOG_INFO("Updated location of %s to (%f, %f, %f)", *ActorName, NewLocation.X, NewLocation.Y, NewLocation.Z);
         bModified = true;
     }
 
     // Check for rotation update
-    const TArray<TSharedPtr<FJsonValue>> *RotationArrayPtr = nullptr;
-    if (Params->TryGetArrayField(FStringView(TEXT("rotation")), RotationArrayPtr) && RotationArrayPtr && RotationArrayPtr->Num() == 3)
+    if (Params.Rotation.IsSet())
     {
-        FRotator NewRotation(
-            (*RotationArrayPtr)[0]->AsNumber(),
-            (*RotationArrayPtr)[1]->AsNumber(),
-            (*RotationArrayPtr)[2]->AsNumber());
-
+        const FRotator& NewRotation = Params.Rotation.GetValue();
         Actor->SetActorRotation(NewRotation);
         MCP_LOG_INFO("Updated rotation of %s to (%f, %f, %f)", *ActorName, NewRotation.Pitch, NewRotation.Yaw, NewRotation.Roll);
         bModified = true;
     }
 
     // Check for scale update
-    const TArray<TSharedPtr<FJsonValue>> *ScaleArrayPtr = nullptr;
-    if (Params->TryGetArrayField(FStringView(TEXT("scale")), ScaleArrayPtr) && ScaleArrayPtr && ScaleArrayPtr->Num() == 3)
+    if (Params.Scale.IsSet())
     {
-        FVector NewScale(
-            (*ScaleArrayPtr)[0]->AsNumber(),
-            (*ScaleArrayPtr)[1]->AsNumber(),
-            (*ScaleArrayPtr)[2]->AsNumber());
-
+        const FVector& NewScale = Params.Scale.GetValue();
         Actor->SetActorScale3D(NewScale);
         MCP_LOG_INFO("Updated scale of %s to (%f, %f, %f)", *ActorName, NewScale.X, NewScale.Y, NewScale.Z);
         bModified = true;
@@ -595,3 +667,237 @@ TSharedPtr<FJsonObject> FMCPExecutePythonHandler::Execute(const TSharedPtr<FJson
         return Response;
     }
 }
+
+//
+// FMCPGetServerStatusHandler
+//
+TSharedPtr<FJsonObject> FMCPGetServerStatusHandler::Execute(const TSharedPtr<FJsonObject> &Params, FSocket *ClientSocket)
+{
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetNumberField("queue_depth", Server.GetPendingCommandCount());
+    Result->SetNumberField("connections", Server.GetNumConnections());
+    Result->SetNumberField("worker_commands", Server.GetNumWorkerCommands());
+    Result->SetNumberField("busy_responses", double(Server.GetBusyResponseCount()));
+    Result->SetNumberField("last_tick_commands", Server.GetLastTickCommandCount());
+    Result->SetNumberField("last_tick_ms", Server.GetLastTickMilliseconds());
+    Result->SetNumberField("frame_budget_ms", Server.GetConfig().FrameBudgetMilliseconds);
+    Result->SetNumberField("receive_buffer_bytes", double(Server.GetReceiveBufferPool().GetLentBytes()));
+    Result->SetNumberField("receive_pool_bytes", double(Server.GetReceiveBufferPool().GetPooledBytes()));
+
+    // Per-command counters, for the commands that have run at least once
+    TSharedPtr<FJsonObject> Commands = MakeShared<FJsonObject>();
+    const TSharedRef<const FMCPDispatchTable> DispatchTable = Server.GetDispatchTable();
+    for (const FMCPDispatchTable::FEntry& Entry : DispatchTable->GetEntries())
+    {
+        const uint64 Dispatches = Entry.Stats->Dispatches.load(std::memory_order_relaxed);
+        if (Dispatches > 0)
+        {
+            TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+            Stats->SetNumberField("dispatches", double(Dispatches));
+            Stats->SetNumberField("total_ms", double(Entry.Stats->TotalMicroseconds.load(std::memory_order_relaxed)) / 1000.0);
+            Commands->SetObjectField(Entry.Name, Stats);
+        }
+    }
+    Result->SetObjectField("commands", Commands);
+
+    TSharedPtr<FJsonObject> Cache = MakeShared<FJsonObject>();
+    Cache->SetNumberField("hits", double(Server.GetResponseCache().GetHits()));
+    Cache->SetNumberField("misses", double(Server.GetResponseCache().GetMisses()));
+    Result->SetObjectField("cache", Cache);
+
+    return CreateSuccessResponse(Result);
+}
+
+//
+// FMCPNegotiateEncodingHandler
+//
+TSharedPtr<FJsonObject> FMCPNegotiateEncodingHandler::Execute(const TSharedPtr<FJsonObject> &Params, FSocket *ClientSocket)
+{
+    // Encodings and compression methods the client can speak, most preferred first
+    const TArray<TSharedPtr<FJsonValue>>* Requested = nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* RequestedCompression = nullptr;
+    const bool bHasEncodings = Params->TryGetArrayField(FStringView(TEXT("encodings")), Requested) && Requested != nullptr;
+    const bool bHasCompression = Params->TryGetArrayField(FStringView(TEXT("compression")), RequestedCompression) && RequestedCompression != nullptr;
+    
+    if (!bHasEncodings && !bHasCompression)
+    {
+        return CreateErrorResponse("Missing 'encodings' or 'compression' field");
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+
+    if (bHasEncodings)
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *Requested)
+        {
+            EMCPWireEncoding Encoding;
+            if (Value.IsValid() && Value->Type == EJson::String && FMCPWireCodec::FromName(Value->AsString(), Encoding))
+            {
+                Result->SetStringField("encoding", FMCPWireCodec::ToName(Encoding));
+                break;
+            }
+        }
+
+        if (!Result->HasField(TEXT("encoding")))
+        {
+            return CreateErrorResponse("None of the requested encodings are supported");
+        }
+    }
+
+    if (bHasCompression)
+    {
+        // zlib is the only method every platform's Core ships with; only length-prefixed frames can carry it
+        const FMCPRequestContext* Request = FMCPTCPServer::GetExecutingRequest();
+        FString Compression = TEXT("none");
+        for (const TSharedPtr<FJsonValue>& Value : *RequestedCompression)
+        {
+            if (Value.IsValid() && Value->Type == EJson::String && Value->AsString().Equals(TEXT("zlib"), ESearchCase::IgnoreCase))
+            {
+                if (Request && Server.EnableResponseCompression(*Request))
+                {
+                    Compression = TEXT("zlib");
+                    Result->SetNumberField("compression_threshold", Server.GetConfig().CompressionThreshold);
+                }
+                break;
+            }
+        }
+        Result->SetStringField("compression", Compression);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Supported;
+    Supported.Add(MakeShared<FJsonValueString>(FMCPWireCodec::ToName(EMCPWireEncoding::Cbor)));
+    Supported.Add(MakeShared<FJsonValueString>(FMCPWireCodec::ToName(EMCPWireEncoding::Json)));
+    Result->SetArrayField("supported", Supported);
+
+    return CreateSuccessResponse(Result);
+}
+
+//
+// FMCPBenchmarkJsonDecodeHandler
+//
+void FMCPBenchmarkJsonDecodeHandler::MakePayload(const FString& Shape, int32 Count, TArray<uint8>& OutPayload)
+{
+    // Spread values over a realistic range of magnitudes and precisions
+    FRandomStream Random(Count);
+    auto RandomNumber = [&Random]() { return FString::SanitizeFloat(Random.FRandRange(-100000.0f, 100000.0f)); };
+
+    FString Json;
+    if (Shape == TEXT("transform"))
+    {
+        Json = TEXT("{\"type\":\"modify_object\",\"params\":{\"name\":\"InstancedFoliage\",\"transforms\":[");
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Json += Index > 0 ? TEXT(",[") : TEXT("[");
+            for (int32 Component = 0; Component < 9; ++Component)
+            {
+                Json += Component > 0 ? TEXT(",") : TEXT("");
+                Json += RandomNumber();
+            }
+            Json += TEXT("]");
+        }
+        Json += TEXT("]}}");
+    }
+    else
+    {
+        Json = TEXT("{\"type\":\"batch\",\"params\":{\"commands\":[");
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Json += FString::Printf(
+                TEXT("%s{\"type\":\"modify_object\",\"id\":%d,\"params\":{\"name\":\"StaticMeshActor_%d\",")
+                TEXT("\"location\":[%s,%s,%s],\"rotation\":[%s,%s,%s],\"scale\":[1,1,1]}}"),
+                Index > 0 ? TEXT(",") : TEXT(""), Index, Index,
+                *RandomNumber(), *RandomNumber(), *RandomNumber(), *RandomNumber(), *RandomNumber(), *RandomNumber());
+        }
+        Json += TEXT("],\"stop_on_error\":false}}");
+    }
+
+    FTCHARToUTF8 Converter(*Json);
+    OutPayload.Reset();
+    OutPayload.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
+
+TSharedPtr<FJsonObject> FMCPBenchmarkJsonDecodeHandler::Execute(const TSharedPtr<FJsonObject> &Params, FSocket *ClientSocket)
+{
+    FString Shape = TEXT("batch");
+    Params->TryGetStringField(FStringView(TEXT("shape")), Shape);
+    if (Shape != TEXT("batch") && Shape != TEXT("transform"))
+    {
+        return CreateErrorResponse(TEXT("'shape' must be \"batch\" or \"transform\""));
+    }
+
+    int32 Count = 10000;
+    int32 Iterations = 10;
+    Params->TryGetNumberField(FStringView(TEXT("count")), Count);
+    Params->TryGetNumberField(FStringView(TEXT("iterations")), Iterations);
+    Count = FMath::Clamp(Count, 1, MCPConstants::BENCHMARK_MAX_COUNT);
+
+    TArray<uint8> Payload;
+    MakePayload(Shape, Count, Payload);
+
+    // Any client may run this, so bound the total work rather than trusting the requested iterations
+    const int64 MaxIterations = FMath::Max<int64>(MCPConstants::BENCHMARK_MAX_DECODE_BYTES / FMath::Max(Payload.Num(), 1), 1);
+    Iterations = int32(FMath::Clamp<int64>(Iterations, 1, FMath::Min<int64>(MaxIterations, 1000)));
+
+    MCP_LOG_INFO("Benchmarking JSON decode: %s x%d (%d bytes), %d iterations", *Shape, Count, Payload.Num(), Iterations);
+
+    // Each decoder is timed over the same bytes; a decoder that rejects them is reported as failed
+    auto TimeDecoder = [&Payload, Iterations](TFunctionRef<bool()> Decode, bool& bOutOk)
+    {
+        bOutOk = true;
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            bOutOk &= Decode();
+        }
+        return (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+    };
+
+    TSharedPtr<FJsonObject> Decoded;
+    FMCPJsonStructuralIndex Index;
+    bool bSerializerOk, bUtf8Ok, bIndexedOk, bIndexOnlyOk;
+
+    const double SerializerMs = TimeDecoder([&Payload, &Decoded]()
+    {
+        FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converter.Length(), Converter.Get()));
+        return FJsonSerializer::Deserialize(Reader, Decoded) && Decoded.IsValid();
+    }, bSerializerOk);
+
+    const double Utf8Ms = TimeDecoder([&Payload, &Decoded]()
+    {
+        return FMCPWireCodec::DecodeJson(Payload.GetData(), Payload.Num(), Decoded, MAX_int32);
+    }, bUtf8Ok);
+
+    const double IndexedMs = TimeDecoder([&Payload, &Decoded]()
+    {
+        return FMCPWireCodec::DecodeJson(Payload.GetData(), Payload.Num(), Decoded, 0);
+    }, bIndexedOk);
+
+    const double IndexOnlyMs = TimeDecoder([&Payload, &Index]()
+    {
+        return Index.Build(Payload.GetData(), Payload.Num());
+    }, bIndexOnlyOk);
+
+    auto MakeTiming = [&Payload](double Milliseconds, bool bOk)
+    {
+        TSharedPtr<FJsonObject> Timing = MakeShared<FJsonObject>();
+        Timing->SetNumberField("ms", Milliseconds);
+        Timing->SetNumberField("mb_per_second", Milliseconds > 0.0 ? Payload.Num() / (Milliseconds * 1000.0) : 0.0);
+        Timing->SetBoolField("ok", bOk);
+        return Timing;
+    };
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField("shape", Shape);
+    Result->SetNumberField("count", Count);
+    Result->SetNumberField("bytes", Payload.Num());
+    Result->SetNumberField("iterations", Iterations);
+    Result->SetNumberField("structurals", Index.GetPositions().Num());
+    Result->SetNumberField("index_threshold", MCPConstants::JSON_STRUCTURAL_INDEX_THRESHOLD);
+    Result->SetObjectField("serializer", MakeTiming(SerializerMs, bSerializerOk));
+    Result->SetObjectField("utf8", MakeTiming(Utf8Ms, bUtf8Ok));
+    Result->SetObjectField("indexed", MakeTiming(IndexedMs, bIndexedOk));
+    Result->SetObjectField("index_only", MakeTiming(IndexOnlyMs, bIndexOnlyOk));
+
+    return CreateSuccessResponse(Result);
+}
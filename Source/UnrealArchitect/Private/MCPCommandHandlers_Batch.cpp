@@ -0,0 +1,169 @@
+#include "MCPCommandHandlers_Batch.h"
+#include "MCPFileLogger.h"
+#include "ScopedTransaction.h"
+
+//
+// FMCPBatchHandler
+//
+TSharedPtr<FJsonObject> FMCPBatchHandler::Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket)
+{
+    const TArray<TSharedPtr<FJsonValue>>* CommandsArrayPtr = nullptr;
+    if (!Params->TryGetArrayField(FStringView(TEXT("commands")), CommandsArrayPtr) || !CommandsArrayPtr)
+    {
+        MCP_LOG_WARNING("Missing 'commands' field in batch command");
+        return CreateErrorResponse("Missing 'commands' field");
+    }
+
+    bool bStopOnError = false;
+    Params->TryGetBoolField(FStringView(TEXT("stop_on_error")), bStopOnError);
+
+    bool bUseTransaction = false;
+    Params->TryGetBoolField(FStringView(TEXT("transaction")), bUseTransaction);
+
+    FString TransactionName = TEXT("MCP Batch");
+    Params->TryGetStringField(FStringView(TEXT("transaction_name")), TransactionName);
+
+    // Entries run nested, and a nested batch or shared_dispatch is refused, so requests cannot recurse
+    if (FMCPTCPServer::IsExecutingNestedCommand())
+    {
+        return CreateErrorResponse("Batches cannot run inside a batch or shared dispatch");
+    }
+
+    MCP_LOG_INFO("Handling batch command with %d sub-commands", CommandsArrayPtr->Num());
+
+    // Group everything the sub-commands record into a single undo step
+    TUniquePtr<FScopedTransaction> Transaction;
+    if (bUseTransaction)
+    {
+        Transaction = MakeUnique<FScopedTransaction>(FText::FromString(TransactionName));
+    }
+
+    TArray<TSharedPtr<FJsonValue>> ResultsArray;
+    ResultsArray.Reserve(CommandsArrayPtr->Num());
+
+    int32 SucceededCount = 0;
+    int32 FailedCount = 0;
+    bool bStopped = false;
+
+    FMCPTCPServer::FNestedCommandScope NestedScope;
+
+    for (const TSharedPtr<FJsonValue>& EntryValue : *CommandsArrayPtr)
+    {
+        const TSharedPtr<FJsonObject>* EntryPtr = nullptr;
+        TSharedPtr<FJsonObject> SubResponse;
+        if (EntryValue.IsValid() && EntryValue->TryGetObject(EntryPtr) && EntryPtr)
+        {
+            SubResponse = ExecuteEntry(*EntryPtr, ClientSocket);
+        }
+        else
+        {
+            SubResponse = CreateErrorResponse("Batch entry must be an object");
+        }
+
+        FString Status;
+        MCPJsonKeys::Status.TryGetString(*SubResponse, Status);
+        const bool bFailed = Status == TEXT("error");
+        if (bFailed)
+        {
+            ++FailedCount;
+        }
+        else
+        {
+            ++SucceededCount;
+        }
+
+        ResultsArray.Add(MakeShared<FJsonValueObject>(SubResponse));
+
+        if (bFailed && bStopOnError)
+        {
+            MCP_LOG_WARNING("Batch stopped at sub-command %d of %d", ResultsArray.Num(), CommandsArrayPtr->Num());
+            bStopped = true;
+            break;
+        }
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetArrayField("results", ResultsArray);
+    Result->SetNumberField("succeeded", SucceededCount);
+    Result->SetNumberField("failed", FailedCount);
+    Result->SetNumberField("skipped", CommandsArrayPtr->Num() - ResultsArray.Num());
+    Result->SetBoolField("stopped", bStopped);
+
+    MCP_LOG_INFO("Batch finished: %d succeeded, %d failed", SucceededCount, FailedCount);
+
+    return CreateSuccessResponse(Result);
+}
+
+double FMCPBatchHandler::GetCost(const TSharedPtr<FJsonObject>& Params) const
+{
+    const TArray<TSharedPtr<FJsonValue>>* CommandsArrayPtr = nullptr;
+    if (!Params->TryGetArrayField(FStringView(TEXT("commands")), CommandsArrayPtr) || !CommandsArrayPtr)
+    {
+        return 1.0;
+    }
+
+    // A nested batch is refused without running anything
+    if (FMCPTCPServer::IsExecutingNestedCommand())
+    {
+        return 1.0;
+    }
+
+    FMCPTCPServer::FNestedCommandScope NestedScope;
+    double Cost = 0.0;
+    for (const TSharedPtr<FJsonValue>& Value : *CommandsArrayPtr)
+    {
+        const TSharedPtr<FJsonObject>* Entry = nullptr;
+        FString Type;
+        const FMCPDispatchTable::FEntry* Command = nullptr;
+        if (Value.IsValid() && Value->TryGetObject(Entry) && Entry && MCPJsonKeys::Type.TryGetString(**Entry, Type))
+        {
+            Command = Server.FindCommand(Type);
+        }
+
+        TSharedPtr<FJsonObject> SubParams;
+        if (Command && Entry && !MCPJsonKeys::Params.TryGetObject(**Entry, SubParams))
+        {
+            SubParams = MakeShared<FJsonObject>();
+        }
+
+        // Malformed and unknown entries only produce an error result, which is as cheap as a simple command
+        Cost += Command ? Command->Handler->GetCost(SubParams) : 1.0;
+    }
+    return FMath::Max(Cost, 1.0);
+}
+
+TSharedPtr<FJsonObject> FMCPBatchHandler::ExecuteEntry(const TSharedPtr<FJsonObject>& Entry, FSocket* ClientSocket)
+{
+    FString Type;
+    if (!MCPJsonKeys::Type.TryGetString(*Entry, Type))
+    {
+        return CreateErrorResponse("Missing 'type' field");
+    }
+
+    const FMCPDispatchTable::FEntry* Command = Server.FindCommand(Type);
+    if (!Command)
+    {
+        return CreateErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *Type));
+    }
+
+    TSharedPtr<FJsonObject> SubParams;
+    if (!MCPJsonKeys::Params.TryGetObject(*Entry, SubParams))
+    {
+        SubParams = MakeShared<FJsonObject>();
+    }
+
+    TSharedPtr<FJsonObject> SubResponse = Command->Execute(SubParams, ClientSocket);
+    if (!SubResponse.IsValid())
+    {
+        SubResponse = CreateErrorResponse(FString::Printf(TEXT("Command '%s' returned no response"), *Type));
+    }
+
+    // Let clients correlate entries they tagged themselves
+    TSharedPtr<FJsonValue> EntryId = MCPJsonKeys::Id.Find(*Entry);
+    if (EntryId.IsValid())
+    {
+        MCPJsonKeys::Id.Set(*SubResponse, EntryId);
+    }
+
+    return SubResponse;
+}
@@ -0,0 +1,213 @@
+#include "MCPCommandHandlers_SharedMemory.h"
+#include "MCPFileLogger.h"
+#include "MCPConstants.h"
+#include "MCPWireEncoding.h"
+
+//
+// FMCPOpenSharedChannelHandler
+//
+TSharedPtr<FJsonObject> FMCPOpenSharedChannelHandler::Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket)
+{
+    int32 Capacity = MCPConstants::DEFAULT_SHARED_CHANNEL_CAPACITY;
+    Params->TryGetNumberField(FStringView(TEXT("capacity")), Capacity);
+
+    if (Capacity <= 0 || Capacity > MCPConstants::MAX_SHARED_CHANNEL_CAPACITY)
+    {
+        return CreateErrorResponse(FString::Printf(TEXT("Capacity must be between 1 and %d bytes"), MCPConstants::MAX_SHARED_CHANNEL_CAPACITY));
+    }
+
+    if (Channels->Num() >= MCPConstants::MAX_SHARED_CHANNELS)
+    {
+        return CreateErrorResponse(TEXT("Too many shared channels are open"));
+    }
+
+    // The channel is closed with the connection that opened it, if the client does not close it first
+    const FMCPRequestContext* Request = FMCPTCPServer::GetExecutingRequest();
+    int32 Id = 0;
+    FMCPSharedMemoryChannel* Channel = Channels->Open(Capacity, Request ? Request->Admission : nullptr, Id);
+    if (!Channel)
+    {
+        return CreateErrorResponse(TEXT("Failed to create shared memory region"));
+    }
+
+    MCP_LOG_INFO("Opened shared channel %d (%s, %d bytes)", Id, *Channel->GetName(), Capacity);
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetNumberField("channel", Id);
+    Result->SetStringField("name", Channel->GetName());
+    Result->SetNumberField("capacity", Channel->GetCapacity());
+    Result->SetNumberField("data_offset", FMCPSharedMemoryChannel::GetDataOffset());
+#if PLATFORM_LINUX
+    // POSIX shared memory objects are visible as files here, which is how clients map them
+    Result->SetStringField("path", FString::Printf(TEXT("/dev/shm/%s"), *Channel->GetName()));
+#endif
+
+    return CreateSuccessResponse(Result);
+}
+
+//
+// FMCPCloseSharedChannelHandler
+//
+TSharedPtr<FJsonObject> FMCPCloseSharedChannelHandler::Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket)
+{
+    int32 Id = 0;
+    if (!Params->TryGetNumberField(FStringView(TEXT("channel")), Id))
+    {
+        return CreateErrorResponse(TEXT("Missing 'channel' field"));
+    }
+
+    if (!Channels->Close(Id))
+    {
+        return CreateErrorResponse(FString::Printf(TEXT("Unknown shared channel: %d"), Id));
+    }
+
+    MCP_LOG_INFO("Closed shared channel %d", Id);
+    return CreateSuccessResponse();
+}
+
+//
+// FMCPSharedDispatchHandler
+//
+bool FMCPSharedDispatchHandler::FindPayload(const TSharedPtr<FJsonObject>& Params, FPayloadRange& OutRange, FMCPSharedMemoryChannel*& OutChannel,
+    FString& OutError) const
+{
+    if (!Params->TryGetNumberField(FStringView(TEXT("channel")), OutRange.Channel)
+        || !Params->TryGetNumberField(FStringView(TEXT("offset")), OutRange.Offset)
+        || !Params->TryGetNumberField(FStringView(TEXT("length")), OutRange.Length))
+    {
+        OutError = TEXT("Missing 'channel', 'offset' or 'length' field");
+        return false;
+    }
+
+    OutChannel = Channels->Find(OutRange.Channel);
+    if (!OutChannel)
+    {
+        OutError = FString::Printf(TEXT("Unknown shared channel: %d"), OutRange.Channel);
+        return false;
+    }
+    return true;
+}
+
+bool FMCPSharedDispatchHandler::DecodePayload(FMCPSharedMemoryChannel& Channel, const FPayloadRange& Range, TSharedPtr<FJsonObject>& OutRequest,
+    bool& bOutReadable, FString& OutError) const
+{
+    const uint8* Data = nullptr;
+    bOutReadable = Channel.View(Range.Offset, Range.Length, Data);
+    if (!bOutReadable)
+    {
+        OutError = TEXT("Shared payload range is not readable");
+        return false;
+    }
+
+    // Decode straight out of shared memory
+    if (!FMCPWireCodec::Decode(Data, Range.Length, OutRequest))
+    {
+        OutError = TEXT("Invalid shared payload format");
+        return false;
+    }
+    return true;
+}
+
+double FMCPSharedDispatchHandler::GetCost(const TSharedPtr<FJsonObject>& Params) const
+{
+    // A nested dispatch is refused without running anything
+    if (FMCPTCPServer::IsExecutingNestedCommand())
+    {
+        return 1.0;
+    }
+
+    FPayloadRange Range;
+    FMCPSharedMemoryChannel* Channel = nullptr;
+    TSharedPtr<FJsonObject> Request;
+    bool bReadable = false;
+    FString Error;
+    if (!FindPayload(Params, Range, Channel, Error) || !DecodePayload(*Channel, Range, Request, bReadable, Error))
+    {
+        // A dispatch that fails only produces an error, which is as cheap as a simple command
+        PeekedRequests.Remove(Range);
+        return 1.0;
+    }
+
+    // The client can rewrite the ring at any time, so the request priced here is the one executed
+    PeekedRequests.Add(Range, Request);
+
+    FString Type;
+    const FMCPDispatchTable::FEntry* Command = nullptr;
+    if (MCPJsonKeys::Type.TryGetString(*Request, Type))
+    {
+        Command = Server.FindCommand(Type);
+    }
+    if (!Command)
+    {
+        return 1.0;
+    }
+
+    TSharedPtr<FJsonObject> SubParams;
+    if (!MCPJsonKeys::Params.TryGetObject(*Request, SubParams))
+    {
+        SubParams = MakeShared<FJsonObject>();
+    }
+
+    FMCPTCPServer::FNestedCommandScope NestedScope;
+    return FMath::Max(Command->Handler->GetCost(SubParams), 1.0);
+}
+
+TSharedPtr<FJsonObject> FMCPSharedDispatchHandler::Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket)
+{
+    // The carried command runs nested, and a nested batch or shared_dispatch is refused, so requests cannot recurse
+    if (FMCPTCPServer::IsExecutingNestedCommand())
+    {
+        return CreateErrorResponse(TEXT("Shared dispatches cannot run inside a batch or shared dispatch"));
+    }
+
+    FPayloadRange Range;
+    FMCPSharedMemoryChannel* Channel = nullptr;
+    FString Error;
+    if (!FindPayload(Params, Range, Channel, Error))
+    {
+        return CreateErrorResponse(Error);
+    }
+
+    TSharedPtr<FJsonObject> Request;
+    bool bReadable = true;
+    const bool bDecoded = PeekedRequests.RemoveAndCopyValue(Range, Request) || DecodePayload(*Channel, Range, Request, bReadable, Error);
+
+    // Hand the space back before the command runs; only a range that was readable may be handed back
+    if (bReadable)
+    {
+        Channel->Release(Range.Offset + Range.Length);
+    }
+
+    if (!bDecoded)
+    {
+        return CreateErrorResponse(Error);
+    }
+
+    FString Type;
+    if (!MCPJsonKeys::Type.TryGetString(*Request, Type))
+    {
+        return CreateErrorResponse(TEXT("Missing 'type' field"));
+    }
+
+    const FMCPDispatchTable::FEntry* Command = Server.FindCommand(Type);
+    if (!Command)
+    {
+        return CreateErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *Type));
+    }
+
+    TSharedPtr<FJsonObject> SubParams;
+    if (!MCPJsonKeys::Params.TryGetObject(*Request, SubParams))
+    {
+        SubParams = MakeShared<FJsonObject>();
+    }
+
+    MCP_LOG_INFO("Processing shared command: %s", *Type);
+
+    FMCPTCPServer::FNestedCommandScope NestedScope;
+    TSharedPtr<FJsonObject> Response = Command->Execute(SubParams, ClientSocket);
+    if (!Response.IsValid())
+    {
+        Response = CreateErrorResponse(FString::Printf(TEXT("Command '%s' returned no response"), *Type));
+    }
+    return Response;
+}
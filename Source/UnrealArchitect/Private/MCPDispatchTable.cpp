@@ -0,0 +1,113 @@
+#include "MCPDispatchTable.h"
+#include "MCPTCPServer.h"
+
+namespace
+{
+    /** Smallest slot array, so small tables never need to grow */
+    constexpr int32 MIN_SLOTS = 16;
+
+    uint8 ToLowerAscii(uint8 Char)
+    {
+        return (Char >= 'A' && Char <= 'Z') ? Char + ('a' - 'A') : Char;
+    }
+
+    /** FNV-1a over the ASCII-lowercased bytes */
+    uint32 HashName(const uint8* Name, int32 Length)
+    {
+        uint32 Hash = 2166136261u;
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            Hash = (Hash ^ ToLowerAscii(Name[Index])) * 16777619u;
+        }
+        return Hash;
+    }
+
+    bool NamesMatch(const TArray<uint8>& EntryName, const uint8* Name, int32 Length)
+    {
+        if (EntryName.Num() != Length)
+        {
+            return false;
+        }
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            if (ToLowerAscii(EntryName[Index]) != ToLowerAscii(Name[Index]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+FMCPDispatchTable::FMCPDispatchTable(const TMap<FString, TSharedPtr<IMCPCommandHandler>>& Handlers, const TMap<FString, TSharedRef<FMCPCommandStats>>& Stats)
+{
+    Entries.Reserve(Handlers.Num());
+    for (const TPair<FString, TSharedPtr<IMCPCommandHandler>>& Pair : Handlers)
+    {
+        FTCHARToUTF8 Converter(*Pair.Key, Pair.Key.Len());
+        TArray<uint8> Utf8Name(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+        const uint32 Hash = HashName(Utf8Name.GetData(), Utf8Name.Num());
+
+        Entries.Add(FEntry{ Pair.Key, MoveTemp(Utf8Name), Hash, Pair.Value, Pair.Value->GetTraits(), Stats.FindChecked(Pair.Key) });
+    }
+
+    // Keep the table at most half full so probe sequences stay short
+    const int32 NumSlots = FMath::Max(MIN_SLOTS, int32(FMath::RoundUpToPowerOfTwo(uint32(Entries.Num() * 2))));
+    Slots.Init(INDEX_NONE, NumSlots);
+
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+    {
+        uint32 Slot = Entries[EntryIndex].Hash & (NumSlots - 1);
+        while (Slots[Slot] != INDEX_NONE)
+        {
+            Slot = (Slot + 1) & (NumSlots - 1);
+        }
+        Slots[Slot] = EntryIndex;
+    }
+}
+
+TSharedPtr<FJsonObject> FMCPDispatchTable::FEntry::Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) const
+{
+    const double StartTime = FPlatformTime::Seconds();
+    TSharedPtr<FJsonObject> Response = Handler->Execute(Params, ClientSocket);
+    Stats->Record(FPlatformTime::Seconds() - StartTime);
+    return Response;
+}
+
+const FMCPDispatchTable::FEntry* FMCPDispatchTable::FindUtf8(const uint8* Name, int32 Length) const
+{
+    const uint32 Mask = uint32(Slots.Num() - 1);
+    const uint32 Hash = HashName(Name, Length);
+
+    for (uint32 Slot = Hash & Mask; Slots[Slot] != INDEX_NONE; Slot = (Slot + 1) & Mask)
+    {
+        const FEntry& Entry = Entries[Slots[Slot]];
+        if (Entry.Hash == Hash && NamesMatch(Entry.Utf8Name, Name, Length))
+        {
+            return &Entry;
+        }
+    }
+    return nullptr;
+}
+
+const FMCPDispatchTable::FEntry* FMCPDispatchTable::Find(FStringView Name) const
+{
+    // Command names are ASCII identifiers, which can be narrowed in place without a conversion
+    uint8 Narrow[64];
+    if (Name.Len() <= UE_ARRAY_COUNT(Narrow))
+    {
+        bool bIsAscii = true;
+        for (int32 Index = 0; Index < Name.Len() && bIsAscii; ++Index)
+        {
+            bIsAscii = uint32(Name[Index]) < 0x80;
+            Narrow[Index] = uint8(Name[Index]);
+        }
+        if (bIsAscii)
+        {
+            return FindUtf8(Narrow, Name.Len());
+        }
+    }
+
+    FTCHARToUTF8 Converter(Name.GetData(), Name.Len());
+    return FindUtf8(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
@@ -17,18 +17,23 @@ public:
             return;
         }
 
+        // Neither command touches editor state, which lets the server schedule them freely
+        const FMCPCommandTraits PureTraits = FMCPCommandTraits().ReadOnly().Idempotent().ThreadSafe();
+        
         // Register a custom "hello_world" command
         FMCPExtensionSystem::RegisterCommand(
             Server,
             "hello_world",
-            FMCPCommandExecuteDelegate::CreateStatic(&FMCPExtensionExample::HandleHelloWorldCommand)
+            FMCPCommandExecuteDelegate::CreateStatic(&FMCPExtensionExample::HandleHelloWorldCommand),
+            PureTraits
         );
         
         // Register a custom "echo" command
         FMCPExtensionSystem::RegisterCommand(
             Server,
             "echo",
-            FMCPCommandExecuteDelegate::CreateStatic(&FMCPExtensionExample::HandleEchoCommand)
+            FMCPCommandExecuteDelegate::CreateStatic(&FMCPExtensionExample::HandleEchoCommand),
+            PureTraits
         );
     }
 
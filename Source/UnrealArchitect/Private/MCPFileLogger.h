@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformFilemanager.h"
+#include "Misc/ScopeLock.h"
 #include "UnrealArchitect.h"
 
 // Shorthand for logger
@@ -97,6 +98,9 @@ public:
         }
         
         FString LogEntry = FString::Printf(TEXT("[%s][%s] %s\n"), *TimeStamp, *VerbosityStr, *Message);
+        
+        // Several threads log at once; keep their lines whole
+        FScopeLock ScopeLock(&FileLock);
         FFileHelper::SaveStringToFile(LogEntry, *LogFilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), EFileWrite::FILEWRITE_Append);
     }
     
@@ -119,4 +123,7 @@ private:
     
     bool bInitialized;
     FString LogFilePath;
+    
+    // Serializes appends to the log file
+    FCriticalSection FileLock;
 }; 
\ No newline at end of file
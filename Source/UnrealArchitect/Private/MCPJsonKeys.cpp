@@ -0,0 +1,40 @@
+#include "MCPJsonKeys.h"
+
+namespace MCPJsonKeys
+{
+    const FMCPJsonKey Type(TEXT("type"));
+    const FMCPJsonKey Params(TEXT("params"));
+    const FMCPJsonKey Id(TEXT("id"));
+    const FMCPJsonKey Status(TEXT("status"));
+    const FMCPJsonKey Message(TEXT("message"));
+    const FMCPJsonKey Result(TEXT("result"));
+    const FMCPJsonKey Stream(TEXT("stream"));
+    const FMCPJsonKey Seq(TEXT("seq"));
+    const FMCPJsonKey Chunks(TEXT("chunks"));
+    const FMCPJsonKey Name(TEXT("name"));
+    const FMCPJsonKey Location(TEXT("location"));
+    const FMCPJsonKey Rotation(TEXT("rotation"));
+    const FMCPJsonKey Scale(TEXT("scale"));
+    const FMCPJsonKey RetryAfterMs(TEXT("retry_after_ms"));
+
+    const TSharedRef<FJsonValue> StatusSuccess = MakeShared<FJsonValueString>(TEXT("success"));
+    const TSharedRef<FJsonValue> StatusError = MakeShared<FJsonValueString>(TEXT("error"));
+    const TSharedRef<FJsonValue> StatusBusy = MakeShared<FJsonValueString>(TEXT("busy"));
+
+    TSharedRef<FJsonObject> MakeErrorResponse(const FString& ErrorMessage)
+    {
+        TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+        Status.Set(*Response, StatusError);
+        Message.Set(*Response, MakeShared<FJsonValueString>(ErrorMessage));
+        return Response;
+    }
+
+    TSharedRef<FJsonObject> MakeBusyResponse(const FString& Reason, double RetryAfterSeconds)
+    {
+        TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+        Status.Set(*Response, StatusBusy);
+        Message.Set(*Response, MakeShared<FJsonValueString>(Reason));
+        RetryAfterMs.Set(*Response, MakeShared<FJsonValueNumber>(FMath::CeilToDouble(RetryAfterSeconds * 1000.0)));
+        return Response;
+    }
+}
@@ -0,0 +1,174 @@
+#include "MCPJsonStructuralIndex.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define MCP_JSON_SCAN_SSE2 1
+#else
+#define MCP_JSON_SCAN_SSE2 0
+#endif
+
+namespace
+{
+    /** Bytes classified per step; one bit per byte in each mask */
+    constexpr int32 BLOCK_SIZE = 64;
+
+    /** Per-byte classification of one block */
+    struct FBlockMasks
+    {
+        uint64 Backslash;
+        uint64 Quote;
+        uint64 Structural;
+        uint64 Control;
+    };
+
+    void ClassifyBlockScalar(const uint8* Block, FBlockMasks& Out)
+    {
+        Out = FBlockMasks{};
+        for (int32 Index = 0; Index < BLOCK_SIZE; ++Index)
+        {
+            const uint64 Bit = uint64(1) << Index;
+            switch (Block[Index])
+            {
+            case '\\': Out.Backslash |= Bit; break;
+            case '"': Out.Quote |= Bit; break;
+            case '{': case '}': case '[': case ']': case ':': case ',': Out.Structural |= Bit; break;
+            default:
+                if (Block[Index] < 0x20)
+                {
+                    Out.Control |= Bit;
+                }
+                break;
+            }
+        }
+    }
+
+#if MCP_JSON_SCAN_SSE2
+    void ClassifyBlockSse2(const uint8* Block, FBlockMasks& Out)
+    {
+        const __m128i Backslash = _mm_set1_epi8('\\');
+        const __m128i Quote = _mm_set1_epi8('"');
+        const __m128i OpenBrace = _mm_set1_epi8('{');
+        const __m128i CloseBrace = _mm_set1_epi8('}');
+        const __m128i OpenBracket = _mm_set1_epi8('[');
+        const __m128i CloseBracket = _mm_set1_epi8(']');
+        const __m128i Colon = _mm_set1_epi8(':');
+        const __m128i Comma = _mm_set1_epi8(',');
+        const __m128i LastControl = _mm_set1_epi8(0x1F);
+
+        Out = FBlockMasks{};
+        for (int32 Lane = 0; Lane < BLOCK_SIZE / 16; ++Lane)
+        {
+            const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + Lane * 16));
+            const int32 Shift = Lane * 16;
+
+            __m128i Structural = _mm_or_si128(_mm_cmpeq_epi8(Bytes, OpenBrace), _mm_cmpeq_epi8(Bytes, CloseBrace));
+            Structural = _mm_or_si128(Structural, _mm_or_si128(_mm_cmpeq_epi8(Bytes, OpenBracket), _mm_cmpeq_epi8(Bytes, CloseBracket)));
+            Structural = _mm_or_si128(Structural, _mm_or_si128(_mm_cmpeq_epi8(Bytes, Colon), _mm_cmpeq_epi8(Bytes, Comma)));
+
+            // Unsigned compare: a byte is a control character when min(byte, 0x1F) is the byte itself
+            const __m128i Control = _mm_cmpeq_epi8(_mm_min_epu8(Bytes, LastControl), Bytes);
+
+            Out.Backslash |= uint64(uint16(_mm_movemask_epi8(_mm_cmpeq_epi8(Bytes, Backslash)))) << Shift;
+            Out.Quote |= uint64(uint16(_mm_movemask_epi8(_mm_cmpeq_epi8(Bytes, Quote)))) << Shift;
+            Out.Structural |= uint64(uint16(_mm_movemask_epi8(Structural))) << Shift;
+            Out.Control |= uint64(uint16(_mm_movemask_epi8(Control))) << Shift;
+        }
+    }
+#endif
+
+    void ClassifyBlock(const uint8* Block, FBlockMasks& Out)
+    {
+#if MCP_JSON_SCAN_SSE2
+        ClassifyBlockSse2(Block, Out);
+#else
+        ClassifyBlockScalar(Block, Out);
+#endif
+    }
+
+    /**
+     * Find the characters escaped by a backslash
+     * Backslashes are rare in requests, so runs of them are resolved bit by bit
+     * @param Backslash - Backslashes in the block
+     * @param bEscapeCarry - In: the block's first byte is escaped; out: the next block's first byte is
+     * @return Mask of escaped characters
+     */
+    uint64 FindEscaped(uint64 Backslash, bool& bEscapeCarry)
+    {
+        uint64 Escaped = bEscapeCarry ? 1 : 0;
+        bEscapeCarry = false;
+
+        uint64 Remaining = Backslash & ~Escaped;
+        while (Remaining != 0)
+        {
+            const int32 Bit = int32(FMath::CountTrailingZeros64(Remaining));
+            if (Bit == BLOCK_SIZE - 1)
+            {
+                bEscapeCarry = true;
+                break;
+            }
+
+            // This backslash escapes the next character, which therefore cannot start an escape itself
+            Escaped |= uint64(1) << (Bit + 1);
+            Remaining &= ~(uint64(3) << Bit);
+        }
+        return Escaped;
+    }
+
+    /** Set every bit from each set bit up to, but not including, the next set bit */
+    uint64 PrefixXor(uint64 Mask)
+    {
+        Mask ^= Mask << 1;
+        Mask ^= Mask << 2;
+        Mask ^= Mask << 4;
+        Mask ^= Mask << 8;
+        Mask ^= Mask << 16;
+        Mask ^= Mask << 32;
+        return Mask;
+    }
+}
+
+bool FMCPJsonStructuralIndex::Build(const uint8* Data, int32 Num)
+{
+    Positions.Reset();
+    Positions.Reserve(Num / 8);
+
+    bool bEscapeCarry = false;
+    uint64 InStringCarry = 0;
+
+    for (int32 BlockStart = 0; BlockStart < Num; BlockStart += BLOCK_SIZE)
+    {
+        FBlockMasks Masks;
+        if (Num - BlockStart >= BLOCK_SIZE)
+        {
+            ClassifyBlock(Data + BlockStart, Masks);
+        }
+        else
+        {
+            // Pad the tail with spaces, which classify as nothing
+            uint8 Tail[BLOCK_SIZE];
+            FMemory::Memset(Tail, ' ', BLOCK_SIZE);
+            FMemory::Memcpy(Tail, Data + BlockStart, Num - BlockStart);
+            ClassifyBlock(Tail, Masks);
+        }
+
+        const uint64 Quote = Masks.Quote & ~FindEscaped(Masks.Backslash, bEscapeCarry);
+
+        // Bits from each opening quote up to its closing quote, continuing a string left open by the previous block
+        const uint64 InString = PrefixXor(Quote) ^ InStringCarry;
+        InStringCarry = (InString >> (BLOCK_SIZE - 1)) != 0 ? ~uint64(0) : 0;
+
+        if ((Masks.Control & InString) != 0)
+        {
+            return false;
+        }
+
+        uint64 Found = (Masks.Structural & ~InString) | Quote;
+        while (Found != 0)
+        {
+            Positions.Add(BlockStart + int32(FMath::CountTrailingZeros64(Found)));
+            Found &= Found - 1;
+        }
+    }
+
+    return InStringCarry == 0;
+}
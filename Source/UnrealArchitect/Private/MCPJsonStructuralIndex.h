@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * First pass over large JSON requests, in the style of simdjson's stage 1
+ * Classifies the text 64 bytes at a time (SSE2 where available, scalar otherwise) and
+ * records the offsets of every structural character outside strings, plus every unescaped
+ * quote. The parser then jumps from an opening quote straight to its closing quote instead
+ * of scanning string contents byte by byte.
+ */
+class FMCPJsonStructuralIndex
+{
+public:
+    /**
+     * Index a UTF-8 JSON text
+     * @param Data - The UTF-8 bytes
+     * @param Num - Number of bytes
+     * @return False if a string is unterminated or contains a raw control character
+     */
+    bool Build(const uint8* Data, int32 Num);
+
+    /** Get the offsets of structural characters and quotes, in ascending order */
+    const TArray<int32>& GetPositions() const { return Positions; }
+
+private:
+    /** Offsets found by the last Build */
+    TArray<int32> Positions;
+};
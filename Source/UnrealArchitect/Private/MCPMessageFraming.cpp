@@ -0,0 +1,319 @@
+#include "MCPMessageFraming.h"
+#include "MCPBufferPool.h"
+#include "Misc/Compression.h"
+
+namespace
+{
+    bool IsJsonWhitespace(uint8 Char)
+    {
+        return Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r';
+    }
+    
+    void WriteBigEndian(uint8* Dest, uint32 Value)
+    {
+        Dest[0] = uint8(Value >> 24);
+        Dest[1] = uint8(Value >> 16);
+        Dest[2] = uint8(Value >> 8);
+        Dest[3] = uint8(Value);
+    }
+    
+    /**
+     * Replace a payload with its uncompressed size followed by its zlib stream
+     * @return False, leaving the payload untouched, if compression would not make it smaller
+     */
+    bool CompressPayload(TArray<uint8>& Payload)
+    {
+        const int32 UncompressedSize = Payload.Num();
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+        
+        TArray<uint8> Compressed;
+        Compressed.SetNumUninitialized(MCPConstants::FRAME_HEADER_SIZE + CompressedSize);
+        if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData() + MCPConstants::FRAME_HEADER_SIZE, CompressedSize, Payload.GetData(), UncompressedSize)
+            || MCPConstants::FRAME_HEADER_SIZE + CompressedSize >= UncompressedSize)
+        {
+            return false;
+        }
+        
+        WriteBigEndian(Compressed.GetData(), uint32(UncompressedSize));
+        Compressed.SetNum(MCPConstants::FRAME_HEADER_SIZE + CompressedSize, EAllowShrinking::No);
+        Payload = MoveTemp(Compressed);
+        return true;
+    }
+}
+
+FMCPMessageFramer::FMCPMessageFramer(EMCPFramingMode InMode, int32 InMaxMessageSize, FMCPBufferPool* InBufferPool)
+    : Mode(InMode)
+    , MaxMessageSize(InMaxMessageSize)
+    , CompressionThreshold(0)
+    , BufferPool(InBufferPool)
+    , ReadOffset(0)
+    , ScanOffset(0)
+    , Depth(0)
+    , bInString(false)
+    , bEscaped(false)
+{
+}
+
+void FMCPMessageFramer::Append(const uint8* Data, int32 Num)
+{
+    if (Num <= 0) return;
+    
+    // Reclaim consumed space before growing, without giving the allocation back
+    if (ReadOffset == Buffer.Num())
+    {
+        Buffer.Reset();
+        ScanOffset = 0;
+        ReadOffset = 0;
+    }
+    else if (ReadOffset > 0 && ReadOffset >= Buffer.Num() / 2)
+    {
+        Buffer.RemoveAt(0, ReadOffset, EAllowShrinking::No);
+        ScanOffset -= ReadOffset;
+        ReadOffset = 0;
+    }
+    
+    if (BufferPool && Buffer.Num() + Num > Buffer.Max())
+    {
+        // Move to a buffer at least twice the size, handing the old one back. Pooled classes are
+        // powers of two anyway; above them, doubling keeps a multi-MB request from being copied
+        // again on every socket read
+        const int32 Needed = Buffer.Num() - ReadOffset + Num;
+        const int32 Doubled = int32(FMath::Min<int64>(int64(Buffer.Max()) * 2, MAX_int32));
+        TArray<uint8> Larger = BufferPool->Acquire(FMath::Max(Needed, Doubled));
+        Larger.Append(Buffer.GetData() + ReadOffset, Buffer.Num() - ReadOffset);
+        BufferPool->Release(MoveTemp(Buffer));
+        Buffer = MoveTemp(Larger);
+        ScanOffset -= ReadOffset;
+        ReadOffset = 0;
+    }
+    
+    Buffer.Append(Data, Num);
+}
+
+void FMCPMessageFramer::ReleaseBuffer()
+{
+    if (BufferPool)
+    {
+        BufferPool->Release(MoveTemp(Buffer));
+    }
+    else
+    {
+        Buffer.Empty();
+    }
+    ReadOffset = 0;
+    ScanOffset = 0;
+}
+
+EMCPFrameResult FMCPMessageFramer::Next(TArray<uint8>& OutMessage)
+{
+    if (!Error.IsEmpty())
+    {
+        return EMCPFrameResult::Error;
+    }
+    
+    if (ReadOffset >= Buffer.Num())
+    {
+        return EMCPFrameResult::NeedMoreData;
+    }
+    
+    if (Mode == EMCPFramingMode::Auto)
+    {
+        // A length prefix below DEFAULT_MAX_MESSAGE_SIZE never starts with '{', '[' or whitespace
+        const uint8 FirstByte = Buffer[ReadOffset];
+        Mode = (FirstByte == '{' || FirstByte == '[' || IsJsonWhitespace(FirstByte))
+            ? EMCPFramingMode::Json
+            : EMCPFramingMode::LengthPrefixed;
+    }
+    
+    switch (Mode)
+    {
+        case EMCPFramingMode::NewlineDelimited:
+            return NextNewlineDelimited(OutMessage);
+        case EMCPFramingMode::LengthPrefixed:
+            return NextLengthPrefixed(OutMessage);
+        default:
+            return NextJson(OutMessage);
+    }
+}
+
+EMCPFrameResult FMCPMessageFramer::NextJson(TArray<uint8>& OutMessage)
+{
+    const uint8* Data = Buffer.GetData();
+    const int32 End = Buffer.Num();
+    int32 Pos = ScanOffset;
+    
+    if (Depth == 0)
+    {
+        // Skip whitespace between messages
+        while (Pos < End && IsJsonWhitespace(Data[Pos]))
+        {
+            ++Pos;
+        }
+        ReadOffset = Pos;
+        ScanOffset = Pos;
+        
+        if (Pos == End)
+        {
+            return EMCPFrameResult::NeedMoreData;
+        }
+        
+        if (Data[Pos] != '{' && Data[Pos] != '[')
+        {
+            return Fail(FString::Printf(TEXT("Expected a JSON object, got byte 0x%02x"), Data[Pos]));
+        }
+    }
+    
+    for (; Pos < End; ++Pos)
+    {
+        const uint8 Char = Data[Pos];
+        
+        if (bInString)
+        {
+            if (bEscaped)
+            {
+                bEscaped = false;
+            }
+            else if (Char == '\\')
+            {
+                bEscaped = true;
+            }
+            else if (Char == '"')
+            {
+                bInString = false;
+            }
+            continue;
+        }
+        
+        switch (Char)
+        {
+            case '"':
+                bInString = true;
+                break;
+            case '{':
+            case '[':
+                ++Depth;
+                break;
+            case '}':
+            case ']':
+                if (--Depth == 0)
+                {
+                    ExtractMessage(ReadOffset, Pos + 1 - ReadOffset, Pos + 1, OutMessage);
+                    return EMCPFrameResult::Message;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    
+    ScanOffset = End;
+    
+    if (End - ReadOffset > MaxMessageSize)
+    {
+        return Fail(FString::Printf(TEXT("Message exceeds the maximum size of %d bytes"), MaxMessageSize));
+    }
+    
+    return EMCPFrameResult::NeedMoreData;
+}
+
+EMCPFrameResult FMCPMessageFramer::NextNewlineDelimited(TArray<uint8>& OutMessage)
+{
+    const uint8* Data = Buffer.GetData();
+    const int32 End = Buffer.Num();
+    
+    for (int32 Pos = ScanOffset; Pos < End; ++Pos)
+    {
+        if (Data[Pos] != '\n')
+        {
+            continue;
+        }
+        
+        int32 MessageEnd = Pos;
+        if (MessageEnd > ReadOffset && Data[MessageEnd - 1] == '\r')
+        {
+            --MessageEnd;
+        }
+        
+        if (MessageEnd == ReadOffset)
+        {
+            // Empty line, nothing to dispatch
+            ReadOffset = Pos + 1;
+            ScanOffset = ReadOffset;
+            continue;
+        }
+        
+        ExtractMessage(ReadOffset, MessageEnd - ReadOffset, Pos + 1, OutMessage);
+        return EMCPFrameResult::Message;
+    }
+    
+    ScanOffset = End;
+    
+    if (End - ReadOffset > MaxMessageSize)
+    {
+        return Fail(FString::Printf(TEXT("Message exceeds the maximum size of %d bytes"), MaxMessageSize));
+    }
+    
+    return EMCPFrameResult::NeedMoreData;
+}
+
+EMCPFrameResult FMCPMessageFramer::NextLengthPrefixed(TArray<uint8>& OutMessage)
+{
+    const int32 Available = Buffer.Num() - ReadOffset;
+    if (Available < MCPConstants::FRAME_HEADER_SIZE)
+    {
+        return EMCPFrameResult::NeedMoreData;
+    }
+    
+    const uint8* Header = Buffer.GetData() + ReadOffset;
+    const uint32 MessageSize = (uint32(Header[0]) << 24) | (uint32(Header[1]) << 16) | (uint32(Header[2]) << 8) | uint32(Header[3]);
+    
+    if (MessageSize > uint32(MaxMessageSize))
+    {
+        return Fail(FString::Printf(TEXT("Message of %u bytes exceeds the maximum size of %d bytes"), MessageSize, MaxMessageSize));
+    }
+    
+    if (Available - MCPConstants::FRAME_HEADER_SIZE < int32(MessageSize))
+    {
+        return EMCPFrameResult::NeedMoreData;
+    }
+    
+    const int32 MessageStart = ReadOffset + MCPConstants::FRAME_HEADER_SIZE;
+    ExtractMessage(MessageStart, int32(MessageSize), MessageStart + int32(MessageSize), OutMessage);
+    return EMCPFrameResult::Message;
+}
+
+void FMCPMessageFramer::ExtractMessage(int32 Start, int32 Num, int32 ConsumedEnd, TArray<uint8>& OutMessage)
+{
+    OutMessage.Reset(Num);
+    OutMessage.Append(Buffer.GetData() + Start, Num);
+    
+    ReadOffset = ConsumedEnd;
+    ScanOffset = ConsumedEnd;
+}
+
+EMCPFrameResult FMCPMessageFramer::Fail(const FString& InError)
+{
+    Error = InError;
+    return EMCPFrameResult::Error;
+}
+
+void FMCPMessageFramer::FrameOutgoing(TArray<uint8>& Payload) const
+{
+    if (Mode == EMCPFramingMode::LengthPrefixed)
+    {
+        uint32 Header = 0;
+        if (CompressionThreshold > 0 && Payload.Num() >= CompressionThreshold && CompressPayload(Payload))
+        {
+            Header = MCPConstants::FRAME_COMPRESSED_FLAG;
+        }
+        
+        Header |= uint32(Payload.Num());
+        Payload.InsertUninitialized(0, MCPConstants::FRAME_HEADER_SIZE);
+        WriteBigEndian(Payload.GetData(), Header);
+    }
+    else
+    {
+        // Text modes terminate every response with a newline
+        Payload.Add('\n');
+    }
+}
@@ -0,0 +1,78 @@
+#include "MCPResponseCache.h"
+#include "MCPWireEncoding.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
+
+FMCPResponseCache::FMCPResponseCache(int32 InMaxEntries)
+    : MaxEntries(InMaxEntries)
+{
+}
+
+uint64 FMCPResponseCache::MakeKey(const FString& CommandName, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& OutKey)
+{
+    // Requests with the same parameters in the same order encode identically
+    FTCHARToUTF8 Name(*CommandName, CommandName.Len());
+    OutKey.Reset();
+    OutKey.Append(reinterpret_cast<const uint8*>(Name.Get()), Name.Length());
+    OutKey.Add(0);
+
+    if (Params.IsValid())
+    {
+        TArray<uint8> EncodedParams;
+        FMCPWireCodec::EncodeJson(Params.ToSharedRef(), EncodedParams);
+        OutKey.Append(EncodedParams);
+    }
+
+    return CityHash64(reinterpret_cast<const char*>(OutKey.GetData()), OutKey.Num());
+}
+
+TSharedPtr<FJsonObject> FMCPResponseCache::Find(const FString& CommandName, const TSharedPtr<FJsonObject>& Params, double Now)
+{
+    TArray<uint8> Key;
+    const uint64 Hash = MakeKey(CommandName, Params, Key);
+
+    FScopeLock ScopeLock(&Lock);
+    const FEntry* Entry = Entries.Find(Hash);
+    if (!Entry || Entry->Key != Key || Entry->ExpiryTime <= Now)
+    {
+        Misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Hits.fetch_add(1, std::memory_order_relaxed);
+
+    // Values are shared, only the top-level field map is copied, so the caller can tag it with a request id
+    return MakeShared<FJsonObject>(*Entry->Response);
+}
+
+void FMCPResponseCache::Add(const FString& CommandName, const TSharedPtr<FJsonObject>& Params, const TSharedRef<FJsonObject>& Response, double ExpiryTime)
+{
+    TArray<uint8> Key;
+    const uint64 Hash = MakeKey(CommandName, Params, Key);
+
+    FScopeLock ScopeLock(&Lock);
+    if (Entries.Num() >= MaxEntries && !Entries.Contains(Hash))
+    {
+        // Make room by dropping what has expired, or everything if nothing has
+        const double Now = FPlatformTime::Seconds();
+        for (TMap<uint64, FEntry>::TIterator It = Entries.CreateIterator(); It; ++It)
+        {
+            if (It.Value().ExpiryTime <= Now)
+            {
+                It.RemoveCurrent();
+            }
+        }
+        if (Entries.Num() >= MaxEntries)
+        {
+            Entries.Reset();
+        }
+    }
+
+    Entries.Add(Hash, FEntry{ MoveTemp(Key), MakeShared<FJsonObject>(*Response), ExpiryTime });
+}
+
+void FMCPResponseCache::Invalidate()
+{
+    FScopeLock ScopeLock(&Lock);
+    Entries.Reset();
+}
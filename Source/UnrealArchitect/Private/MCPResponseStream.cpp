@@ -0,0 +1,89 @@
+#include "MCPResponseStream.h"
+#include "MCPFileLogger.h"
+#include "MCPJsonKeys.h"
+
+FMCPResponseStream::FMCPResponseStream(FMCPTCPServer& InServer, const FMCPRequestContext& InContext)
+    : Server(InServer)
+    , Context(InContext)
+    , bBegun(false)
+    , bFinished(false)
+    , NumChunks(0)
+{
+}
+
+TSharedPtr<FJsonObject> FMCPResponseStream::MakeFrame(const TCHAR* Kind) const
+{
+    TSharedPtr<FJsonObject> Frame = MakeShared<FJsonObject>();
+    MCPJsonKeys::Status.Set(*Frame, MCPJsonKeys::StatusSuccess);
+    MCPJsonKeys::Stream.Set(*Frame, MakeShared<FJsonValueString>(Kind));
+    return Frame;
+}
+
+void FMCPResponseStream::Begin(const TSharedPtr<FJsonObject>& Header)
+{
+    if (bBegun)
+    {
+        MCP_LOG_WARNING("Response stream already begun");
+        return;
+    }
+    bBegun = true;
+
+    TSharedPtr<FJsonObject> Frame = MakeFrame(TEXT("begin"));
+    MCPJsonKeys::Result.Set(*Frame, MakeShared<FJsonValueObject>(Header.IsValid() ? Header : MakeShared<FJsonObject>()));
+    Server.SendResponse(Context, Frame);
+}
+
+void FMCPResponseStream::SendChunk(const TSharedPtr<FJsonObject>& Chunk)
+{
+    if (bFinished)
+    {
+        MCP_LOG_WARNING("Dropping chunk sent after the response stream ended");
+        return;
+    }
+    if (!bBegun)
+    {
+        Begin();
+    }
+
+    TSharedPtr<FJsonObject> Frame = MakeFrame(TEXT("chunk"));
+    MCPJsonKeys::Seq.Set(*Frame, MakeShared<FJsonValueNumber>(NumChunks++));
+    MCPJsonKeys::Result.Set(*Frame, MakeShared<FJsonValueObject>(Chunk.IsValid() ? Chunk : MakeShared<FJsonObject>()));
+    Server.SendResponse(Context, Frame);
+}
+
+void FMCPResponseStream::End(const TSharedPtr<FJsonObject>& Trailer)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    if (!bBegun)
+    {
+        Begin();
+    }
+    bFinished = true;
+
+    TSharedPtr<FJsonObject> Frame = MakeFrame(TEXT("end"));
+    MCPJsonKeys::Chunks.Set(*Frame, MakeShared<FJsonValueNumber>(NumChunks));
+    MCPJsonKeys::Result.Set(*Frame, MakeShared<FJsonValueObject>(Trailer.IsValid() ? Trailer : MakeShared<FJsonObject>()));
+    Server.SendResponse(Context, Frame);
+}
+
+void FMCPResponseStream::Fail(const FString& Message)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    if (!bBegun)
+    {
+        Begin();
+    }
+    bFinished = true;
+
+    TSharedPtr<FJsonObject> Frame = MakeFrame(TEXT("end"));
+    MCPJsonKeys::Status.Set(*Frame, MCPJsonKeys::StatusError);
+    MCPJsonKeys::Message.Set(*Frame, MakeShared<FJsonValueString>(Message));
+    MCPJsonKeys::Chunks.Set(*Frame, MakeShared<FJsonValueNumber>(NumChunks));
+    Server.SendResponse(Context, Frame);
+}
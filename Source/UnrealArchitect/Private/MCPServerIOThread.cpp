@@ -0,0 +1,40 @@
+#include "MCPServerIOThread.h"
+#include "MCPTCPServer.h"
+#include "MCPFileLogger.h"
+#include "HAL/PlatformTime.h"
+
+FMCPServerIOThread::FMCPServerIOThread(FMCPTCPServer& InServer)
+    : Server(InServer)
+    , bStopRequested(false)
+{
+}
+
+bool FMCPServerIOThread::Init()
+{
+    MCP_LOG_VERBOSE("MCP I/O thread starting");
+    return true;
+}
+
+uint32 FMCPServerIOThread::Run()
+{
+    double LastTime = FPlatformTime::Seconds();
+    
+    while (!bStopRequested.load(std::memory_order_relaxed))
+    {
+        const double Now = FPlatformTime::Seconds();
+        const float DeltaTime = static_cast<float>(Now - LastTime);
+        LastTime = Now;
+        
+        // Blocks in the poller until sockets are ready or a response is queued
+        Server.TickIO(DeltaTime);
+    }
+    
+    MCP_LOG_VERBOSE("MCP I/O thread exiting");
+    return 0;
+}
+
+void FMCPServerIOThread::Stop()
+{
+    bStopRequested.store(true, std::memory_order_relaxed);
+    Server.WakeIOThread();
+}
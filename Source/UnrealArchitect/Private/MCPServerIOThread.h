@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FMCPTCPServer;
+
+/**
+ * Runnable that owns the server's socket I/O
+ * Loops accepting connections, reading requests and writing responses until stopped
+ */
+class FMCPServerIOThread : public FRunnable
+{
+public:
+    /**
+     * Constructor
+     * @param InServer - The server whose sockets this thread services
+     */
+    explicit FMCPServerIOThread(FMCPTCPServer& InServer);
+
+    //~ Begin FRunnable Interface
+    virtual bool Init() override;
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+    //~ End FRunnable Interface
+
+private:
+    /** The server being serviced */
+    FMCPTCPServer& Server;
+
+    /** Set when the thread has been asked to exit */
+    std::atomic<bool> bStopRequested;
+};
@@ -0,0 +1,151 @@
+#include "MCPSharedMemoryChannel.h"
+#include "MCPConstants.h"
+#include "MCPFileLogger.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Guid.h"
+
+#if PLATFORM_LINUX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(FMCPSharedRingHeader) <= FMCPSharedMemoryChannel::GetDataOffset(), "Shared ring header overlaps the data area");
+
+TUniquePtr<FMCPSharedMemoryChannel> FMCPSharedMemoryChannel::Create(const FString& Name, int32 Capacity)
+{
+#if PLATFORM_LINUX
+    // Payloads can drive execute_python, so only the editor's user may map the region. The engine
+    // creates regions readable and writable by everyone, so create the object first with owner-only
+    // access; the engine then opens the existing object, whose mode it leaves alone. O_EXCL also
+    // refuses a name another user has created in advance.
+    const FTCHARToUTF8 ObjectName(*(TEXT("/") + Name));
+    const int Fd = shm_open(ObjectName.Get(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (Fd < 0)
+    {
+        MCP_LOG_ERROR("Failed to create shared memory object %s (errno %d)", *Name, errno);
+        return nullptr;
+    }
+    fchmod(Fd, S_IRUSR | S_IWUSR);
+    close(Fd);
+#endif
+
+    FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(
+        Name, true, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, GetDataOffset() + Capacity);
+    if (!Region)
+    {
+        MCP_LOG_ERROR("Failed to create shared memory region %s (%d bytes)", *Name, Capacity);
+#if PLATFORM_LINUX
+        shm_unlink(ObjectName.Get());
+#endif
+        return nullptr;
+    }
+
+    return TUniquePtr<FMCPSharedMemoryChannel>(new FMCPSharedMemoryChannel(Name, Region, Capacity));
+}
+
+FMCPSharedMemoryChannel::FMCPSharedMemoryChannel(const FString& InName, FPlatformMemory::FSharedMemoryRegion* InRegion, int32 InCapacity)
+    : Name(InName)
+    , Region(InRegion)
+    , Header(static_cast<FMCPSharedRingHeader*>(InRegion->GetAddress()))
+    , Data(static_cast<const uint8*>(InRegion->GetAddress()) + GetDataOffset())
+    , Capacity(InCapacity)
+{
+    Header->Version = 1;
+    Header->Capacity = uint64(Capacity);
+    Header->WriteOffset = 0;
+    Header->ReadOffset = 0;
+
+    // Publish the magic last so a client that maps early never sees a half-initialised header
+    FPlatformMisc::MemoryBarrier();
+    Header->Magic = MCPConstants::SHARED_RING_MAGIC;
+}
+
+FMCPSharedMemoryChannel::~FMCPSharedMemoryChannel()
+{
+    // The creator's unmap also removes the name, so stale regions do not outlive the editor
+    FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+}
+
+bool FMCPSharedMemoryChannel::View(int64 Offset, int32 Length, const uint8*& OutData) const
+{
+    const int64 Written = FPlatformAtomics::AtomicRead(&Header->WriteOffset);
+    const int64 Consumed = Header->ReadOffset;
+
+    // The range must be written, not yet consumed, and the client must not have lapped the reader
+    if (Length <= 0 || Length > Capacity || Offset < Consumed || Offset + Length > Written || Written - Consumed > Capacity)
+    {
+        return false;
+    }
+
+    const int64 Start = Offset % Capacity;
+    if (Start + Length > Capacity)
+    {
+        return false;
+    }
+
+    OutData = Data + Start;
+    return true;
+}
+
+void FMCPSharedMemoryChannel::Release(int64 EndOffset)
+{
+    if (EndOffset > Header->ReadOffset)
+    {
+        FPlatformAtomics::AtomicStore(&Header->ReadOffset, EndOffset);
+    }
+}
+
+FMCPSharedMemoryChannel* FMCPSharedChannelRegistry::Open(int32 Capacity, const TSharedPtr<FMCPClientAdmission>& Owner, int32& OutId)
+{
+    const int32 Id = NextId++;
+    // The random part keeps other local users from guessing the name before the region exists
+    const FString Name = FString::Printf(TEXT("MCPChannel_%u_%d_%s"), FPlatformProcess::GetCurrentProcessId(), Id,
+        *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+
+    TUniquePtr<FMCPSharedMemoryChannel> Channel = FMCPSharedMemoryChannel::Create(Name, Capacity);
+    if (!Channel)
+    {
+        return nullptr;
+    }
+
+    if (Owner.IsValid())
+    {
+        Owners.Add(Id, Owner);
+    }
+
+    OutId = Id;
+    return Channels.Add(Id, MoveTemp(Channel)).Get();
+}
+
+FMCPSharedMemoryChannel* FMCPSharedChannelRegistry::Find(int32 Id) const
+{
+    const TUniquePtr<FMCPSharedMemoryChannel>* Channel = Channels.Find(Id);
+    return Channel ? Channel->Get() : nullptr;
+}
+
+bool FMCPSharedChannelRegistry::Close(int32 Id)
+{
+    Owners.Remove(Id);
+    return Channels.Remove(Id) > 0;
+}
+
+int32 FMCPSharedChannelRegistry::CloseAbandoned()
+{
+    int32 NumClosed = 0;
+    for (TMap<int32, TWeakPtr<FMCPClientAdmission>>::TIterator It = Owners.CreateIterator(); It; ++It)
+    {
+        // The connection drops its admission state when it is cleaned up, and marks it closed for requests still holding it
+        const TSharedPtr<FMCPClientAdmission> Owner = It.Value().Pin();
+        if (!Owner.IsValid() || Owner->IsClosed())
+        {
+            MCP_LOG_INFO("Closing shared channel %d left open by a disconnected client", It.Key());
+            Channels.Remove(It.Key());
+            It.RemoveCurrent();
+            ++NumClosed;
+        }
+    }
+    return NumClosed;
+}
@@ -0,0 +1,197 @@
+#include "MCPSocketPoller.h"
+#include "MCPFileLogger.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Sockets.h"
+
+#if MCP_WITH_EPOLL
+#include "BSDSockets/SocketsBSD.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace
+{
+    /**
+     * Polling fallback: only sleeps, the server checks every socket itself
+     */
+    class FMCPPollingSocketPoller : public FMCPSocketPoller
+    {
+    public:
+        FMCPPollingSocketPoller()
+            : WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+        {
+        }
+        
+        virtual ~FMCPPollingSocketPoller()
+        {
+            FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        }
+        
+        virtual bool IsEventDriven() const override { return false; }
+        virtual void AddListener(FSocket* Socket) override {}
+        virtual void Add(FSocket* Socket, const FMCPSlotHandle& Connection) override {}
+        virtual void SetWantsWrite(FSocket* Socket, const FMCPSlotHandle& Connection, bool bWantsWrite) override {}
+        virtual void Remove(FSocket* Socket) override {}
+        
+        virtual void Wait(float TimeoutSeconds, TArray<FMCPSocketEvent>& OutEvents) override
+        {
+            OutEvents.Reset();
+            WakeEvent->Wait(FTimespan::FromSeconds(TimeoutSeconds));
+        }
+        
+        virtual void Wake() override
+        {
+            WakeEvent->Trigger();
+        }
+        
+    private:
+        FEvent* WakeEvent;
+    };
+
+#if MCP_WITH_EPOLL
+    /**
+     * epoll-backed poller for Linux
+     */
+    class FMCPEpollSocketPoller : public FMCPSocketPoller
+    {
+    public:
+        /** Tokens stored in epoll_event.data for the non-client descriptors */
+        static constexpr uint64 ListenerToken = MAX_uint64;
+        static constexpr uint64 WakeToken = MAX_uint64 - 1;
+        
+        /** Most events returned by a single Wait */
+        static constexpr int32 MaxEventsPerWait = 256;
+        
+        FMCPEpollSocketPoller(int InEpollFd, int InWakeFd)
+            : EpollFd(InEpollFd)
+            , WakeFd(InWakeFd)
+        {
+            epoll_event Event = {};
+            Event.events = EPOLLIN;
+            Event.data.u64 = WakeToken;
+            epoll_ctl(EpollFd, EPOLL_CTL_ADD, WakeFd, &Event);
+        }
+        
+        virtual ~FMCPEpollSocketPoller()
+        {
+            close(WakeFd);
+            close(EpollFd);
+        }
+        
+        virtual bool IsEventDriven() const override { return true; }
+        
+        virtual void AddListener(FSocket* Socket) override
+        {
+            Control(EPOLL_CTL_ADD, Socket, EPOLLIN, ListenerToken);
+        }
+        
+        virtual void Add(FSocket* Socket, const FMCPSlotHandle& Connection) override
+        {
+            Control(EPOLL_CTL_ADD, Socket, EPOLLIN | EPOLLRDHUP, ToToken(Connection));
+        }
+        
+        virtual void SetWantsWrite(FSocket* Socket, const FMCPSlotHandle& Connection, bool bWantsWrite) override
+        {
+            Control(EPOLL_CTL_MOD, Socket, EPOLLIN | EPOLLRDHUP | (bWantsWrite ? EPOLLOUT : 0), ToToken(Connection));
+        }
+        
+        virtual void Remove(FSocket* Socket) override
+        {
+            epoll_ctl(EpollFd, EPOLL_CTL_DEL, GetDescriptor(Socket), nullptr);
+        }
+        
+        virtual void Wait(float TimeoutSeconds, TArray<FMCPSocketEvent>& OutEvents) override
+        {
+            OutEvents.Reset();
+            
+            epoll_event Events[MaxEventsPerWait];
+            const int32 NumEvents = epoll_wait(EpollFd, Events, MaxEventsPerWait, FMath::CeilToInt(TimeoutSeconds * 1000.0f));
+            
+            for (int32 Index = 0; Index < NumEvents; ++Index)
+            {
+                const epoll_event& Event = Events[Index];
+                
+                if (Event.data.u64 == WakeToken)
+                {
+                    uint64 Count = 0;
+                    ssize_t Ignored = read(WakeFd, &Count, sizeof(Count));
+                    (void)Ignored;
+                    continue;
+                }
+                
+                FMCPSocketEvent& Out = OutEvents.AddDefaulted_GetRef();
+                Out.bListener = Event.data.u64 == ListenerToken;
+                Out.Connection = FromToken(Event.data.u64);
+                Out.bReadable = (Event.events & EPOLLIN) != 0;
+                Out.bWritable = (Event.events & EPOLLOUT) != 0;
+                Out.bClosed = (Event.events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) != 0;
+            }
+        }
+        
+        virtual void Wake() override
+        {
+            const uint64 One = 1;
+            ssize_t Ignored = write(WakeFd, &One, sizeof(One));
+            (void)Ignored;
+        }
+        
+    private:
+        static int GetDescriptor(FSocket* Socket)
+        {
+            return static_cast<FSocketBSD*>(Socket)->GetNativeSocket();
+        }
+        
+        static uint64 ToToken(const FMCPSlotHandle& Connection)
+        {
+            return (uint64(uint32(Connection.Index)) << 32) | uint64(Connection.Generation);
+        }
+        
+        static FMCPSlotHandle FromToken(uint64 Token)
+        {
+            FMCPSlotHandle Handle;
+            Handle.Index = int32(uint32(Token >> 32));
+            Handle.Generation = uint32(Token);
+            return Handle;
+        }
+        
+        void Control(int Operation, FSocket* Socket, uint32 Events, uint64 Token)
+        {
+            epoll_event Event = {};
+            Event.events = Events;
+            Event.data.u64 = Token;
+            if (epoll_ctl(EpollFd, Operation, GetDescriptor(Socket), &Event) != 0)
+            {
+                MCP_LOG_WARNING("epoll_ctl failed with errno %d", errno);
+            }
+        }
+        
+        int EpollFd;
+        int WakeFd;
+    };
+#endif
+}
+
+TUniquePtr<FMCPSocketPoller> FMCPSocketPoller::Create(bool bPreferEventDriven)
+{
+#if MCP_WITH_EPOLL
+    if (bPreferEventDriven)
+    {
+        const int EpollFd = epoll_create1(EPOLL_CLOEXEC);
+        const int WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (EpollFd >= 0 && WakeFd >= 0)
+        {
+            MCP_LOG_INFO("Using epoll for MCP socket readiness");
+            return MakeUnique<FMCPEpollSocketPoller>(EpollFd, WakeFd);
+        }
+        
+        MCP_LOG_WARNING("Failed to create epoll instance (errno %d), falling back to polling", errno);
+        if (EpollFd >= 0) close(EpollFd);
+        if (WakeFd >= 0) close(WakeFd);
+    }
+#endif
+    
+    return MakeUnique<FMCPPollingSocketPoller>();
+}
@@ -1,4 +1,7 @@
 #include "MCPTCPServer.h"
+#include "MCPServerIOThread.h"
+#include "MCPResponseStream.h"
+#include "MCPUnixSocketListener.h"
 #include "Engine/World.h"
 #include "Editor.h"
 #include "LevelEditor.h"
@@ -13,22 +16,105 @@
 #include "ActorEditorUtils.h"
 #include "EngineUtils.h"
 #include "Containers/Ticker.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/MemStack.h"
 #include "UnrealArchitect.h"
 #include "MCPFileLogger.h"
 #include "MCPCommandHandlers.h"
 #include "MCPCommandHandlers_Blueprints.h"
 #include "MCPCommandHandlers_Materials.h"
+#include "MCPCommandHandlers_Batch.h"
+#include "MCPCommandHandlers_SharedMemory.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/Guid.h"
 #include "MCPConstants.h"
+#include "MCPJsonKeys.h"
 
+namespace
+{
+    /** A connection deadline */
+    enum class EMCPConnectionDeadline : uint8
+    {
+        None,
+        Idle,
+        Request,
+        Write
+    };
+
+    /**
+     * Work out which of a connection's deadlines comes first
+     * @param Connection - The client connection
+     * @param Config - Server configuration holding the timeouts
+     * @param OutKind - Which deadline it is
+     * @return The deadline, in FPlatformTime::Seconds, or MAX_dbl if none applies
+     */
+    double GetConnectionDeadline(const FMCPClientConnection& Connection, const FMCPTCPServerConfig& Config, EMCPConnectionDeadline& OutKind)
+    {
+        double Deadline = MAX_dbl;
+        OutKind = EMCPConnectionDeadline::None;
+        
+        const auto Consider = [&Deadline, &OutKind](double Start, float TimeoutSeconds, EMCPConnectionDeadline Kind)
+        {
+            if (Start > 0.0 && TimeoutSeconds > 0.0f && Start + TimeoutSeconds < Deadline)
+            {
+                Deadline = Start + TimeoutSeconds;
+                OutKind = Kind;
+            }
+        };
+        
+        Consider(Connection.LastActivityTime, Config.ClientTimeoutSeconds, EMCPConnectionDeadline::Idle);
+        Consider(Connection.RequestStartTime, Config.RequestTimeoutSeconds, EMCPConnectionDeadline::Request);
+        Consider(Connection.LastWriteProgressTime, Config.WriteTimeoutSeconds, EMCPConnectionDeadline::Write);
+        return Deadline;
+    }
+    
+    /** The request whose handler is executing on this thread */
+    thread_local const FMCPRequestContext* ExecutingRequest = nullptr;
+}
+
+const FMCPRequestContext* FMCPTCPServer::GetExecutingRequest()
+{
+    return ExecutingRequest;
+}
+
+bool FMCPTCPServer::IsExecutingNestedCommand()
+{
+    return ExecutingRequest && ExecutingRequest->NestingDepth > 0;
+}
+
+FMCPTCPServer::FNestedCommandScope::FNestedCommandScope()
+    : Previous(ExecutingRequest)
+{
+    if (Previous)
+    {
+        Nested = *Previous;
+    }
+    ++Nested.NestingDepth;
+    ExecutingRequest = &Nested;
+}
+
+FMCPTCPServer::FNestedCommandScope::~FNestedCommandScope()
+{
+    ExecutingRequest = Previous;
+}
 
 FMCPTCPServer::FMCPTCPServer(const FMCPTCPServerConfig& InConfig) 
     : Config(InConfig)
-    , Listener(nullptr)
+    , ListenSocket(nullptr)
+    , UnixListenSocket(nullptr)
     , bRunning(false)
+    , PendingCommandCount(0)
+    , NumConnections(0)
+    , BusyResponseCount(0)
+    , NumWorkerCommands(0)
+    , LastTickCommandCount(0)
+    , LastTickMilliseconds(0.0)
+    , IOThread(nullptr)
+    , Poller(FMCPSocketPoller::Create(InConfig.bUseEventPoller))
+    , SharedChannels(MakeShared<FMCPSharedChannelRegistry>())
+    , DispatchTable(MakeShared<FMCPDispatchTable>(CommandHandlers, CommandStats))
 {
     // Register default command handlers
     RegisterCommandHandler(MakeShared<FMCPGetSceneInfoHandler>());
@@ -36,6 +122,9 @@ FMCPTCPServer::FMCPTCPServer(const FMCPTCPServerConfig& InConfig)
     RegisterCommandHandler(MakeShared<FMCPModifyObjectHandler>());
     RegisterCommandHandler(MakeShared<FMCPDeleteObjectHandler>());
     RegisterCommandHandler(MakeShared<FMCPExecutePythonHandler>());
+    RegisterCommandHandler(MakeShared<FMCPGetServerStatusHandler>(*this));
+    RegisterCommandHandler(MakeShared<FMCPNegotiateEncodingHandler>(*this));
+    RegisterCommandHandler(MakeShared<FMCPBenchmarkJsonDecodeHandler>());
 
     // Material command handlers
     RegisterCommandHandler(MakeShared<FMCPCreateMaterialHandler>());
@@ -47,6 +136,14 @@ FMCPTCPServer::FMCPTCPServer(const FMCPTCPServerConfig& InConfig)
     RegisterCommandHandler(MakeShared<FMCPModifyBlueprintHandler>());
     RegisterCommandHandler(MakeShared<FMCPGetBlueprintInfoHandler>());
     RegisterCommandHandler(MakeShared<FMCPCreateBlueprintEventHandler>());
+
+    // Batch command, dispatches sub-commands through this server's handler map
+    RegisterCommandHandler(MakeShared<FMCPBatchHandler>(*this));
+
+    // Shared memory channel handlers, for bulk payloads from clients on this machine
+    RegisterCommandHandler(MakeShared<FMCPOpenSharedChannelHandler>(SharedChannels));
+    RegisterCommandHandler(MakeShared<FMCPCloseSharedChannelHandler>(SharedChannels));
+    RegisterCommandHandler(MakeShared<FMCPSharedDispatchHandler>(*this, SharedChannels));
 }
 
 FMCPTCPServer::~FMCPTCPServer()
@@ -70,6 +167,7 @@ void FMCPTCPServer::RegisterCommandHandler(TSharedPtr<IMCPCommandHandler> Handle
     }
 
     CommandHandlers.Add(CommandName, Handler);
+    RebuildDispatchTable();
     MCP_LOG_INFO("Registered command handler for '%s'", *CommandName);
 }
 
@@ -77,6 +175,7 @@ void FMCPTCPServer::UnregisterCommandHandler(const FString& CommandName)
 {
     if (CommandHandlers.Remove(CommandName) > 0)
     {
+        RebuildDispatchTable();
         MCP_LOG_INFO("Unregistered command handler for '%s'", *CommandName);
     }
     else
@@ -109,6 +208,7 @@ bool FMCPTCPServer::RegisterExternalCommandHandler(TSharedPtr<IMCPCommandHandler
 
     // Register the handler
     CommandHandlers.Add(CommandName, Handler);
+    RebuildDispatchTable();
     MCP_LOG_INFO("Registered external command handler for '%s'", *CommandName);
     return true;
 }
@@ -130,10 +230,25 @@ bool FMCPTCPServer::UnregisterExternalCommandHandler(const FString& CommandName)
 
     // Unregister the handler
     CommandHandlers.Remove(CommandName);
+    RebuildDispatchTable();
     MCP_LOG_INFO("Unregistered external command handler for '%s'", *CommandName);
     return true;
 }
 
+void FMCPTCPServer::RebuildDispatchTable()
+{
+    for (const TPair<FString, TSharedPtr<IMCPCommandHandler>>& Pair : CommandHandlers)
+    {
+        if (!CommandStats.Contains(Pair.Key))
+        {
+            CommandStats.Add(Pair.Key, MakeShared<FMCPCommandStats>());
+        }
+    }
+    
+    // Lookups in flight keep the old table alive through their shared reference
+    DispatchTable = MakeShared<FMCPDispatchTable>(CommandHandlers, CommandStats);
+}
+
 bool FMCPTCPServer::Start()
 {
     if (bRunning)
@@ -145,8 +260,13 @@ bool FMCPTCPServer::Start()
     MCP_LOG_WARNING("Starting MCP server on port %d", Config.Port);
     
     // Use a simple ASCII string for the socket description to avoid encoding issues
-    Listener = new FTcpListener(FIPv4Endpoint(FIPv4Address::Any, Config.Port));
-    if (!Listener || !Listener->IsActive())
+    ListenSocket = FTcpSocketBuilder(TEXT("MCPListener"))
+        .AsNonBlocking()
+        .AsReusable()
+        .BoundToEndpoint(FIPv4Endpoint(FIPv4Address::Any, Config.Port))
+        .Listening(MCPConstants::DEFAULT_LISTEN_BACKLOG)
+        .Build();
+    if (!ListenSocket)
     {
         MCP_LOG_ERROR("Failed to start MCP server on port %d", Config.Port);
         Stop();
@@ -155,23 +275,82 @@ bool FMCPTCPServer::Start()
 
     // Clear any existing client connections
     ClientConnections.Empty();
+    
+    Poller->AddListener(ListenSocket);
+    
+    // Same-host clients can skip the loopback TCP stack; TCP keeps working if this fails
+    if (!Config.UnixSocketPath.IsEmpty())
+    {
+        UnixListenSocket = FMCPUnixSocketListener::Create(Config.UnixSocketPath, MCPConstants::DEFAULT_LISTEN_BACKLOG);
+        if (UnixListenSocket)
+        {
+            Poller->AddListener(UnixListenSocket);
+            MCP_LOG_INFO("MCP Server also listening on %s", *Config.UnixSocketPath);
+        }
+    }
 
     TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPTCPServer::Tick), Config.TickIntervalSeconds);
     bRunning = true;
+    
+    // Socket I/O runs on its own thread from here on
+    IORunnable = MakeUnique<FMCPServerIOThread>(*this);
+    IOThread = FRunnableThread::Create(IORunnable.Get(), TEXT("MCPServerIO"), 0, TPri_AboveNormal);
+    if (!IOThread)
+    {
+        MCP_LOG_ERROR("Failed to create MCP server I/O thread");
+        Stop();
+        return false;
+    }
+    
     MCP_LOG_INFO("MCP Server started on port %d", Config.Port);
     return true;
 }
 
 void FMCPTCPServer::Stop()
 {
+    // Let worker commands finish while the I/O thread can still deliver their responses;
+    // they never wait on the game thread, so this cannot deadlock
+    UE::Tasks::Wait(WorkerTasks);
+    WorkerTasks.Empty();
+    
+    // Join the I/O thread first so nothing else touches the sockets below
+    if (IOThread)
+    {
+        IOThread->Kill(true);
+        delete IOThread;
+        IOThread = nullptr;
+    }
+    IORunnable.Reset();
+    
     // Clean up all client connections
     CleanupAllClientConnections();
     
-    if (Listener)
+    if (ListenSocket)
+    {
+        Poller->Remove(ListenSocket);
+        ListenSocket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+        ListenSocket = nullptr;
+    }
+    
+    if (UnixListenSocket)
+    {
+        Poller->Remove(UnixListenSocket);
+        FMCPUnixSocketListener::Destroy(UnixListenSocket, Config.UnixSocketPath);
+        UnixListenSocket = nullptr;
+    }
+    
+    // Drop anything still in flight between the threads
+    PendingCommands.Empty();
+    for (TQueue<FMCPReadyCommand, EQueueMode::Spsc>& Ready : ReadyCommands)
     {
-        delete Listener;
-        Listener = nullptr;
+        Ready.Empty();
     }
+    ConnectionBacklogs.Empty();
+    ActiveStreams.Empty();
+    PendingCommandCount.store(0, std::memory_order_relaxed);
+    ResponseCache.Invalidate();
+    PendingResponses.Empty();
     
     if (TickerHandle.IsValid())
     {
@@ -187,21 +366,209 @@ bool FMCPTCPServer::Tick(float DeltaTime)
 {
     if (!bRunning) return false;
     
-    // Normal processing
-    ProcessPendingConnections();
-    ProcessClientData();
-    CheckClientTimeouts(DeltaTime);
+    // Channels are owned by the game thread, so those of disconnected clients are closed here
+    SharedChannels->CloseAbandoned();
+    
+    // Sockets are serviced by the I/O thread; the game thread only executes commands
+    ProcessPendingCommands();
     return true;
 }
 
+void FMCPTCPServer::TickIO(float DeltaTime)
+{
+    const bool bEventDriven = Poller->IsEventDriven();
+    
+    // Block until sockets are ready, a response is queued or the wait times out
+    Poller->Wait(bEventDriven ? Config.IOEventWaitSeconds : Config.IOWaitSeconds, SocketEvents);
+    
+    if (bEventDriven)
+    {
+        // Only touch the sockets that have something to do
+        ProcessSocketEvents();
+    }
+    else
+    {
+        ProcessPendingConnections();
+        ProcessClientData();
+    }
+    
+    ProcessPendingResponses();
+    
+    if (!bEventDriven)
+    {
+        FlushAllOutbound();
+    }
+    
+    CheckClientTimeouts();
+}
+
+void FMCPTCPServer::ProcessSocketEvents()
+{
+    for (const FMCPSocketEvent& Event : SocketEvents)
+    {
+        if (Event.bListener)
+        {
+            ProcessPendingConnections();
+            continue;
+        }
+        
+        // The connection may have been closed by an earlier event in this batch
+        FMCPClientConnection* ClientConnection = ClientConnections.Find(Event.Connection);
+        if (!ClientConnection)
+        {
+            continue;
+        }
+        
+        if (Event.bReadable || Event.bClosed)
+        {
+            // A hang-up normally shows up as a failed read once the remaining data is consumed;
+            // one that leaves nothing to read would otherwise be reported again on every poll
+            int32 BytesRead = 0;
+            if (!ReceiveClientData(*ClientConnection, &BytesRead) || (Event.bClosed && BytesRead == 0))
+            {
+                CleanupClientConnection(*ClientConnection);
+                continue;
+            }
+        }
+        
+        if (Event.bWritable && !FlushOutbound(*ClientConnection))
+        {
+            CleanupClientConnection(*ClientConnection);
+        }
+    }
+}
+
+void FMCPTCPServer::WakeIOThread()
+{
+    Poller->Wake();
+}
+
+void FMCPTCPServer::ProcessPendingCommands()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = Config.FrameBudgetMilliseconds / 1000.0;
+    int32 CommandCount = 0;
+    
+    // Decode what has arrived and file it by priority, so control commands and quick edits are not
+    // stuck behind bulk work from another client. Decoding is game thread time too, so it stops once
+    // the budget is spent; the rest stays queued in arrival order for the next tick
+    FMCPPendingCommand Pending;
+    while (PendingCommands.Dequeue(Pending))
+    {
+        ScheduleCommandPayload(Pending.Payload, Pending.Context);
+        
+        if (BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+    }
+    
+    // Forget worker commands that have finished
+    WorkerTasks.RemoveAllSwap([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+    
+    // Continue streamed responses a step each; their time counts against the same budget
+    for (int32 Index = 0; Index < ActiveStreams.Num(); )
+    {
+        if (BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+        
+        if (StepStream(ActiveStreams[Index]))
+        {
+            FinishRequest(ActiveStreams[Index].Stream->GetContext());
+            ActiveStreams.RemoveAt(Index);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+    
+    // Always make progress on at least one command, then stop once the budget is spent
+    for (;;)
+    {
+        FMCPReadyCommand Ready;
+        bool bHaveCommand = false;
+        for (int32 Priority = 0; Priority < int32(EMCPCommandPriority::Num) && !bHaveCommand; ++Priority)
+        {
+            bHaveCommand = ReadyCommands[Priority].Dequeue(Ready);
+        }
+        if (!bHaveCommand)
+        {
+            break;
+        }
+        ReleaseBacklog(Ready);
+        
+        bool bFinished = true;
+        {
+            // Request-scoped arena: scratch that the handler or response encoding puts on the
+            // FMemStack is released in one step once the response has been queued
+            FMemMark RequestMark(FMemStack::Get());
+            // The entry was resolved when the command was scheduled; only bad requests are looked up again
+            bFinished = Ready.Entry
+                ? ExecuteCommand(*Ready.Entry, Ready.Command, Ready.Context)
+                : DispatchCommand(Ready.Command, Ready.Context);
+        }
+        if (bFinished)
+        {
+            FinishRequest(Ready.Context);
+        }
+        ++CommandCount;
+        
+        if (BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+    }
+    
+    LastTickCommandCount = CommandCount;
+    LastTickMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    
+    if (CommandCount > 0 && Config.bEnableVerboseLogging)
+    {
+        MCP_LOG_VERBOSE("Executed %d commands in %.2f ms, %d still queued", 
+            CommandCount, LastTickMilliseconds, GetPendingCommandCount());
+    }
+}
+
 void FMCPTCPServer::ProcessPendingConnections()
 {
-    if (!Listener) return;
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
     
-    // Always accept new connections
-    if (!Listener->OnConnectionAccepted().IsBound())
+    // Accept everything that is waiting
+    bool bHasPendingConnection = false;
+    while (ListenSocket && ListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
     {
-        Listener->OnConnectionAccepted().BindRaw(this, &FMCPTCPServer::HandleConnectionAccepted);
+        TSharedRef<FInternetAddr> RemoteAddress = SocketSubsystem->CreateInternetAddr();
+        FSocket* ClientSocket = ListenSocket->Accept(*RemoteAddress, TEXT("MCPClient"));
+        if (!ClientSocket)
+        {
+            break;
+        }
+        
+        if (!HandleConnectionAccepted(ClientSocket, FIPv4Endpoint(RemoteAddress)))
+        {
+            ClientSocket->Close();
+            SocketSubsystem->DestroySocket(ClientSocket);
+        }
+    }
+    
+    // Unix domain peers have no IP address; they are always local
+    bHasPendingConnection = false;
+    while (UnixListenSocket && UnixListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+    {
+        FSocket* ClientSocket = UnixListenSocket->Accept(TEXT("MCPUnixClient"));
+        if (!ClientSocket)
+        {
+            break;
+        }
+        
+        if (!HandleConnectionAccepted(ClientSocket, FIPv4Endpoint(FIPv4Address::InternalLoopback, 0)))
+        {
+            ClientSocket->Close();
+            SocketSubsystem->DestroySocket(ClientSocket);
+        }
     }
 }
 
@@ -215,11 +582,22 @@ bool FMCPTCPServer::HandleConnectionAccepted(FSocket* InSocket, const FIPv4Endpo
 
     MCP_LOG_VERBOSE("Connection attempt from %s", *Endpoint.ToString());
     
-    // Accept all connections
+    if (Config.MaxConnections > 0 && ClientConnections.Num() >= Config.MaxConnections)
+    {
+        MCP_LOG_WARNING("Refusing connection from %s, already serving %d clients", *Endpoint.ToString(), ClientConnections.Num());
+        return false;
+    }
+    
     InSocket->SetNonBlocking(true);
     
-    // Add to our list of client connections
-    ClientConnections.Add(FMCPClientConnection(InSocket, Endpoint, Config.ReceiveBufferSize));
+    // Add to our table of client connections
+    const FMCPConnectionHandle Handle = ClientConnections.Add(FMCPClientConnection(InSocket, Endpoint, Config.FramingMode, Config.MaxMessageSize, &ReceiveBufferPool));
+    ClientConnections.Find(Handle)->Handle = Handle;
+    ClientConnections.Find(Handle)->Admission = MakeShared<FMCPClientAdmission>(Config.RateLimitPerSecond, Config.RateLimitBurst);
+    SocketConnections.Add(InSocket, Handle);
+    Poller->Add(InSocket, Handle);
+    UpdateConnectionDeadline(*ClientConnections.Find(Handle));
+    NumConnections.store(ClientConnections.Num(), std::memory_order_relaxed);
     
     MCP_LOG_INFO("MCP Client connected from %s (Total clients: %d)", *Endpoint.ToString(), ClientConnections.Num());
     return true;
@@ -227,11 +605,10 @@ bool FMCPTCPServer::HandleConnectionAccepted(FSocket* InSocket, const FIPv4Endpo
 
 void FMCPTCPServer::ProcessClientData()
 {
-    // Make a copy of the array since we might modify it during iteration
-    TArray<FMCPClientConnection> ConnectionsCopy = ClientConnections;
-    
-    for (FMCPClientConnection& ClientConnection : ConnectionsCopy)
+    // Slots are stable, so failed connections can be cleaned up as we go
+    for (TMCPSlotMap<FMCPClientConnection>::TIterator It = ClientConnections.CreateIterator(); It; ++It)
     {
+        FMCPClientConnection& ClientConnection = *It;
         if (!ClientConnection.Socket) continue;
         
         // Check if the client is still connected
@@ -283,60 +660,184 @@ void FMCPTCPServer::ProcessClientData()
                     *ClientConnection.Endpoint.ToString(), PendingDataSize);
             }
             
-            // Reset timeout timer since we're receiving data
-            ClientConnection.TimeSinceLastActivity = 0.0f;
-            
-            int32 BytesRead = 0;
-            if (ClientConnection.Socket->Recv(ClientConnection.ReceiveBuffer.GetData(), ClientConnection.ReceiveBuffer.Num(), BytesRead))
-            {
-                if (BytesRead > 0)
-                {
-                    if (Config.bEnableVerboseLogging)
-                    {
-                        MCP_LOG_VERBOSE("Read %d bytes from client %s", BytesRead, *ClientConnection.Endpoint.ToString());
-                    }
-                    
-                    // Null-terminate the buffer to ensure it's a valid string
-                    ClientConnection.ReceiveBuffer[BytesRead] = 0;
-                    FString ReceivedData = FString(UTF8_TO_TCHAR(ClientConnection.ReceiveBuffer.GetData()));
-                    ProcessCommand(ReceivedData, ClientConnection.Socket);
-                }
-            }
-            else
+            if (!ReceiveClientData(ClientConnection))
             {
-                // Check if it's a real error or just a non-blocking socket that would block
-                int32 ErrorCode = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
-                if (ErrorCode != SE_EWOULDBLOCK)
-                {
-                    // Real connection error, close the socket
-                    MCP_LOG_WARNING("Socket error %d for client %s, closing connection", 
-                        ErrorCode, *ClientConnection.Endpoint.ToString());
-                    CleanupClientConnection(ClientConnection);
-                }
+                CleanupClientConnection(ClientConnection);
             }
         }
     }
 }
 
-void FMCPTCPServer::CheckClientTimeouts(float DeltaTime)
+bool FMCPTCPServer::ReceiveClientData(FMCPClientConnection& ClientConnection, int32* OutBytesRead)
 {
-    // Make a copy of the array since we might modify it during iteration
-    TArray<FMCPClientConnection> ConnectionsCopy = ClientConnections;
+    bool bConnectionOk = true;
+    int32 TotalBytesRead = 0;
     
-    for (FMCPClientConnection& ClientConnection : ConnectionsCopy)
+    // One read buffer serves every connection, since only the I/O thread reads
+    if (ReceiveScratch.Num() != Config.ReceiveBufferSize)
     {
-        if (!ClientConnection.Socket) continue;
+        ReceiveScratch.SetNumUninitialized(Config.ReceiveBufferSize);
+    }
+    
+    // Drain the socket so large and back-to-back messages are picked up in one pass
+    for (;;)
+    {
+        int32 BytesRead = 0;
+        if (!ClientConnection.Socket->Recv(ReceiveScratch.GetData(), ReceiveScratch.Num(), BytesRead))
+        {
+            // A stream socket that would block reports success with no bytes, so failure means the peer
+            // closed the connection or it broke. The error code is not reset by an orderly close and
+            // may be left over from an earlier call, so it is only logged.
+            MCP_LOG_INFO("Client %s disconnected (last socket error %d)", 
+                *ClientConnection.Endpoint.ToString(), ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode());
+            
+            // Requests already received are still dispatched below
+            bConnectionOk = false;
+            break;
+        }
+        
+        if (BytesRead <= 0)
+        {
+            break;
+        }
+        
+        if (Config.bEnableVerboseLogging)
+        {
+            MCP_LOG_VERBOSE("Read %d bytes from client %s", BytesRead, *ClientConnection.Endpoint.ToString());
+        }
+        
+        TotalBytesRead += BytesRead;
+        ClientConnection.LastActivityTime = FPlatformTime::Seconds();
+        ClientConnection.Framer.Append(ReceiveScratch.GetData(), BytesRead);
+        
+        if (BytesRead < ReceiveScratch.Num())
+        {
+            // Socket is drained for now
+            break;
+        }
+    }
+    
+    if (OutBytesRead)
+    {
+        *OutBytesRead = TotalBytesRead;
+    }
+    
+    // Hand every complete message to the game thread
+    bool bCompletedRequest = false;
+    for (;;)
+    {
+        FMCPPendingCommand Pending;
+        const EMCPFrameResult Result = ClientConnection.Framer.Next(Pending.Payload);
+        
+        if (Result == EMCPFrameResult::NeedMoreData)
+        {
+            break;
+        }
+        
+        if (Result == EMCPFrameResult::Error)
+        {
+            MCP_LOG_WARNING("Malformed stream from client %s (%s), closing connection", 
+                *ClientConnection.Endpoint.ToString(), *ClientConnection.Framer.GetError());
+            return false;
+        }
+        
+        Pending.Context.Connection = ClientConnection.Handle;
+        Pending.Context.ClientSocket = ClientConnection.Socket;
+        Pending.Context.bLengthPrefixed = ClientConnection.Framer.GetMode() == EMCPFramingMode::LengthPrefixed;
+        bCompletedRequest = true;
+        
+        // Refuse here rather than let one client fill the game thread's queue
+        if (!ClientConnection.Admission->TryBeginRequest(Config.MaxInFlightRequests))
+        {
+            RejectBusy(Pending.Payload, Pending.Context, FString::Printf(TEXT("Too many requests in flight (limit %d)"), Config.MaxInFlightRequests),
+                MCPConstants::BUSY_RETRY_AFTER_SECONDS);
+            continue;
+        }
+        
+        Pending.Context.Admission = ClientConnection.Admission;
+        PendingCommandCount.fetch_add(1, std::memory_order_relaxed);
+        PendingCommands.Enqueue(MoveTemp(Pending));
+    }
+    
+    // A request is in progress while bytes are buffered; its clock starts with the read that began it
+    if (ClientConnection.Framer.GetBufferedBytes() == 0)
+    {
+        ClientConnection.RequestStartTime = 0.0;
+        
+        // Nothing partial to keep, so the connection can go quiet without holding a buffer
+        ClientConnection.Framer.ReleaseBuffer();
+    }
+    else if (bCompletedRequest || ClientConnection.RequestStartTime == 0.0)
+    {
+        ClientConnection.RequestStartTime = ClientConnection.LastActivityTime;
+    }
+    
+    UpdateConnectionDeadline(ClientConnection);
+    return bConnectionOk;
+}
+
+void FMCPTCPServer::CheckClientTimeouts()
+{
+    const double Now = FPlatformTime::Seconds();
+    
+    ConnectionTimers.Advance(Now, [this, Now](const FMCPConnectionHandle& Handle, double Deadline)
+    {
+        // Timers outlive their connection and are superseded when a deadline moves earlier
+        FMCPClientConnection* ClientConnection = ClientConnections.Find(Handle);
+        if (!ClientConnection || !ClientConnection->Socket || ClientConnection->TimerDeadline != Deadline)
+        {
+            return;
+        }
         
-        // Increment time since last activity
-        ClientConnection.TimeSinceLastActivity += DeltaTime;
+        EMCPConnectionDeadline Kind;
+        double CurrentDeadline = GetConnectionDeadline(*ClientConnection, Config, Kind);
+        if (CurrentDeadline <= Now && Kind == EMCPConnectionDeadline::Idle
+            && ClientConnection->Admission.IsValid() && ClientConnection->Admission->GetInFlight() > 0)
+        {
+            // A client waiting on a slow command is not idle; its clock restarts from the last
+            // check, and again when the response is written
+            ClientConnection->LastActivityTime = Now;
+            CurrentDeadline = GetConnectionDeadline(*ClientConnection, Config, Kind);
+        }
+        
+        if (CurrentDeadline > Now)
+        {
+            // Activity pushed the deadline back since the timer was scheduled
+            ClientConnection->TimerDeadline = CurrentDeadline;
+            if (Kind != EMCPConnectionDeadline::None)
+            {
+                ConnectionTimers.Schedule(Handle, CurrentDeadline);
+            }
+            return;
+        }
         
-        // Check if client has timed out
-        if (ClientConnection.TimeSinceLastActivity > Config.ClientTimeoutSeconds)
+        switch (Kind)
         {
+        case EMCPConnectionDeadline::Request:
+            MCP_LOG_WARNING("Client from %s did not finish sending a request within %.1f seconds, disconnecting", 
+                *ClientConnection->Endpoint.ToString(), Config.RequestTimeoutSeconds);
+            break;
+        case EMCPConnectionDeadline::Write:
+            MCP_LOG_WARNING("Client from %s did not read its responses for %.1f seconds, disconnecting", 
+                *ClientConnection->Endpoint.ToString(), Now - ClientConnection->LastWriteProgressTime);
+            break;
+        default:
             MCP_LOG_WARNING("Client from %s timed out after %.1f seconds of inactivity, disconnecting", 
-                *ClientConnection.Endpoint.ToString(), ClientConnection.TimeSinceLastActivity);
-            CleanupClientConnection(ClientConnection);
+                *ClientConnection->Endpoint.ToString(), Now - ClientConnection->LastActivityTime);
+            break;
         }
+        CleanupClientConnection(*ClientConnection);
+    });
+}
+
+void FMCPTCPServer::UpdateConnectionDeadline(FMCPClientConnection& ClientConnection)
+{
+    EMCPConnectionDeadline Kind;
+    const double Deadline = GetConnectionDeadline(ClientConnection, Config, Kind);
+    if (Kind != EMCPConnectionDeadline::None && Deadline < ClientConnection.TimerDeadline)
+    {
+        ClientConnection.TimerDeadline = Deadline;
+        ConnectionTimers.Schedule(ClientConnection.Handle, Deadline);
     }
 }
 
@@ -344,16 +845,16 @@ void FMCPTCPServer::CleanupAllClientConnections()
 {
     MCP_LOG_INFO("Cleaning up all client connections (%d total)", ClientConnections.Num());
     
-    // Make a copy of the array since we'll be modifying it during iteration
-    TArray<FMCPClientConnection> ConnectionsCopy = ClientConnections;
-    
-    for (FMCPClientConnection& Connection : ConnectionsCopy)
+    for (TMCPSlotMap<FMCPClientConnection>::TIterator It = ClientConnections.CreateIterator(); It; ++It)
     {
-        CleanupClientConnection(Connection);
+        CleanupClientConnection(*It);
     }
     
-    // Ensure the array is empty
+    // Ensure the table is empty
     ClientConnections.Empty();
+    SocketConnections.Empty();
+    ConnectionTimers.Empty();
+    NumConnections.store(0, std::memory_order_relaxed);
 }
 
 void FMCPTCPServer::CleanupClientConnection(FSocket* ClientSocket)
@@ -361,12 +862,11 @@ void FMCPTCPServer::CleanupClientConnection(FSocket* ClientSocket)
     if (!ClientSocket) return;
     
     // Find the client connection with this socket
-    for (FMCPClientConnection& Connection : ClientConnections)
+    if (const FMCPConnectionHandle* Handle = SocketConnections.Find(ClientSocket))
     {
-        if (Connection.Socket == ClientSocket)
+        if (FMCPClientConnection* Connection = ClientConnections.Find(*Handle))
         {
-            CleanupClientConnection(Connection);
-            break;
+            CleanupClientConnection(*Connection);
         }
     }
 }
@@ -383,6 +883,9 @@ void FMCPTCPServer::CleanupClientConnection(FMCPClientConnection& ClientConnecti
         FString SocketDesc = GetSafeSocketDescription(ClientConnection.Socket);
         MCP_LOG_VERBOSE("Closing client socket with description: %s", *SocketDesc);
         
+        // Stop watching the socket before its descriptor is released
+        Poller->Remove(ClientConnection.Socket);
+        
         // First close the socket
         bool bCloseSuccess = ClientConnection.Socket->Close();
         if (!bCloseSuccess)
@@ -411,132 +914,528 @@ void FMCPTCPServer::CleanupClientConnection(FMCPClientConnection& ClientConnecti
         MCP_LOG_ERROR("Unknown exception while cleaning up client connection");
     }
     
-    // Remove from our list of connections
-    ClientConnections.RemoveAll([&ClientConnection](const FMCPClientConnection& Connection) {
-        return Connection.Socket == ClientConnection.Socket;
-    });
+    // Work still in progress for this client is abandoned rather than finished
+    if (ClientConnection.Admission.IsValid())
+    {
+        ClientConnection.Admission->MarkClosed();
+    }
+    
+    // Remove from our table of connections; this destroys ClientConnection
+    ClientConnection.Framer.ReleaseBuffer();
+    SocketConnections.Remove(ClientConnection.Socket);
+    ClientConnections.Remove(ClientConnection.Handle);
+    NumConnections.store(ClientConnections.Num(), std::memory_order_relaxed);
     
     MCP_LOG_INFO("MCP Client disconnected (Remaining clients: %d)", ClientConnections.Num());
 }
 
-void FMCPTCPServer::ProcessCommand(const FString& CommandJson, FSocket* ClientSocket)
+void FMCPTCPServer::ScheduleCommandPayload(const TArray<uint8>& Payload, const FMCPRequestContext& InContext)
 {
-    if (Config.bEnableVerboseLogging)
+    // Decoder scratch on the FMemStack is released here; the decoded objects live on the heap
+    FMemMark DecodeMark(FMemStack::Get());
+    
+    FMCPRequestContext Context = InContext;
+    Context.Encoding = FMCPWireCodec::Detect(Payload);
+    const bool bIsCbor = Context.Encoding == EMCPWireEncoding::Cbor;
+    
+    // Only widen JSON text for display when it is actually being logged
+    if (Config.bEnableVerboseLogging && !bIsCbor)
     {
-        MCP_LOG_VERBOSE("Processing command: %s", *CommandJson);
+        FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+        MCP_LOG_VERBOSE("Processing command: %s", *FString(Converter.Length(), Converter.Get()));
     }
     
+    // Both encodings decode straight from the received bytes, with no intermediate FString
     TSharedPtr<FJsonObject> Command;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(CommandJson);
-    if (FJsonSerializer::Deserialize(Reader, Command) && Command.IsValid())
+    const bool bDecoded = bIsCbor
+        ? FMCPWireCodec::DecodeCbor(Payload, Command)
+        : FMCPWireCodec::DecodeJson(Payload.GetData(), Payload.Num(), Command);
+    
+    if (!bDecoded)
     {
-        FString Type;
-        if (Command->TryGetStringField(FStringView(TEXT("type")), Type))
+        MCP_LOG_WARNING("Invalid %s payload (%d bytes)", bIsCbor ? TEXT("CBOR") : TEXT("JSON"), Payload.Num());
+        
+        SendResponse(Context, MCPJsonKeys::MakeErrorResponse(bIsCbor ? TEXT("Invalid CBOR format") : TEXT("Invalid JSON format")));
+        FinishRequest(Context);
+        return;
+    }
+    
+    // Clients pipelining several requests on one connection tag them with an id and match
+    // responses by it, since queries and thread-safe commands may complete out of order
+    TSharedPtr<FJsonValue> RequestId = MCPJsonKeys::Id.Find(*Command);
+    if (RequestId.IsValid() && (RequestId->Type == EJson::String || RequestId->Type == EJson::Number))
+    {
+        Context.RequestId = RequestId;
+    }
+    
+    // Requests for unknown commands are only answered with an error, which is quick, so they go first
+    EMCPCommandPriority Priority = EMCPCommandPriority::High;
+    bool bEdit = false;
+    const TSharedRef<const FMCPDispatchTable> Table = GetDispatchTable();
+    const FMCPDispatchTable::FEntry* Entry = nullptr;
+    FString Type;
+    if (MCPJsonKeys::Type.TryGetString(*Command, Type))
+    {
+        Entry = Table->Find(Type);
+        if (Entry)
         {
-            TSharedPtr<IMCPCommandHandler> Handler = CommandHandlers.FindRef(Type);
-            if (Handler.IsValid())
+            // Commands that never touch UObjects need not wait for, or add to, the game thread's frame
+            // Streams are advanced by the game thread tick, so streamed requests stay there
+            bool bStream = false;
+            const bool bStreamed = MCPJsonKeys::Stream.TryGetBool(*Command, bStream) && bStream && Entry->Handler->SupportsStreaming();
+            if (Entry->Traits.bThreadSafe && Config.bRunThreadSafeCommandsOnWorkers && !bStreamed)
             {
-                MCP_LOG_INFO("Processing command: %s", *Type);
-                
-                const TSharedPtr<FJsonObject>* ParamsPtr = nullptr;
-                TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
-                
-                if (Command->TryGetObjectField(FStringView(TEXT("params")), ParamsPtr) && ParamsPtr != nullptr)
-                {
-                    Params = *ParamsPtr;
-                }
-                
-                // Handle the command and get the response
-                TSharedPtr<FJsonObject> Response = Handler->Execute(Params, ClientSocket);
-                
-                // Send the response
-                SendResponse(ClientSocket, Response);
-            }
-            else
-            {
-                MCP_LOG_WARNING("Unknown command: %s", *Type);
-                
-                TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-                Response->SetStringField("status", "error");
-                Response->SetStringField("message", FString::Printf(TEXT("Unknown command: %s"), *Type));
-                SendResponse(ClientSocket, Response);
+                LaunchWorkerCommand(Table, *Entry, MoveTemp(Command), MoveTemp(Context));
+                return;
             }
+            Priority = Entry->Traits.Priority;
+            bEdit = !Entry->Traits.bReadOnly;
+        }
+    }
+    
+    // A client must see its own edits applied in the order it sent them (batch creates X, then
+    // modify_object changes X), so a command is filed no earlier than the latest queue holding
+    // something it must not overtake from the same connection
+    FMCPConnectionBacklog& Backlog = ConnectionBacklogs.FindOrAdd(Context.Connection);
+    const int32* MustFollow = bEdit ? Backlog.Commands : Backlog.Edits;
+    int32 Queue = int32(Priority);
+    for (int32 Later = int32(EMCPCommandPriority::Num) - 1; Later > Queue; --Later)
+    {
+        if (MustFollow[Later] > 0)
+        {
+            Queue = Later;
+            break;
+        }
+    }
+    
+    ++Backlog.Commands[Queue];
+    if (bEdit)
+    {
+        ++Backlog.Edits[Queue];
+    }
+    
+    FMCPReadyCommand Ready;
+    Ready.Command = MoveTemp(Command);
+    Ready.Context = MoveTemp(Context);
+    Ready.Priority = EMCPCommandPriority(Queue);
+    Ready.bEdit = bEdit;
+    Ready.Table = Table;
+    Ready.Entry = Entry;
+    ReadyCommands[Queue].Enqueue(MoveTemp(Ready));
+}
+
+void FMCPTCPServer::ReleaseBacklog(const FMCPReadyCommand& Ready)
+{
+    FMCPConnectionBacklog* Backlog = ConnectionBacklogs.Find(Ready.Context.Connection);
+    if (!Backlog)
+    {
+        return;
+    }
+    
+    --Backlog->Commands[int32(Ready.Priority)];
+    if (Ready.bEdit)
+    {
+        --Backlog->Edits[int32(Ready.Priority)];
+    }
+    
+    for (int32 Waiting : Backlog->Commands)
+    {
+        if (Waiting > 0)
+        {
+            return;
+        }
+    }
+    ConnectionBacklogs.Remove(Ready.Context.Connection);
+}
+
+void FMCPTCPServer::FinishRequest(const FMCPRequestContext& Context)
+{
+    PendingCommandCount.fetch_sub(1, std::memory_order_relaxed);
+    
+    if (Context.Admission.IsValid())
+    {
+        Context.Admission->EndRequest();
+    }
+}
+
+void FMCPTCPServer::RejectBusy(const TArray<uint8>& Payload, FMCPRequestContext Context, const FString& Reason, double RetryAfterSeconds)
+{
+    FMemMark RequestMark(FMemStack::Get());
+
+    // The client matches the refusal to its request by id; the rest of the request, params
+    // included, is stepped over rather than decoded
+    Context.Encoding = FMCPWireCodec::Detect(Payload);
+    TSharedPtr<FJsonValue> RequestId = FMCPWireCodec::FindScalarMember(Payload.GetData(), Payload.Num(), *MCPJsonKeys::Id.Name);
+    if (RequestId.IsValid() && (RequestId->Type == EJson::String || RequestId->Type == EJson::Number))
+    {
+        Context.RequestId = RequestId;
+    }
+    
+    BusyResponseCount.fetch_add(1, std::memory_order_relaxed);
+    SendResponse(Context, MCPJsonKeys::MakeBusyResponse(Reason, RetryAfterSeconds));
+}
+
+bool FMCPTCPServer::DispatchCommand(const TSharedPtr<FJsonObject>& Command, const FMCPRequestContext& Context)
+{
+    FString Type;
+    if (MCPJsonKeys::Type.TryGetString(*Command, Type))
+    {
+        const FMCPDispatchTable::FEntry* Entry = FindCommand(Type);
+        if (Entry)
+        {
+            return ExecuteCommand(*Entry, Command, Context);
         }
         else
         {
-            MCP_LOG_WARNING("Missing 'type' field in command");
+            MCP_LOG_WARNING("Unknown command: %s", *Type);
             
-            TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-            Response->SetStringField("status", "error");
-            Response->SetStringField("message", TEXT("Missing 'type' field"));
-            SendResponse(ClientSocket, Response);
+            SendResponse(Context, MCPJsonKeys::MakeErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *Type)));
         }
     }
     else
     {
-        MCP_LOG_WARNING("Invalid JSON format: %s", *CommandJson);
+        MCP_LOG_WARNING("Missing 'type' field in command");
         
-        TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-        Response->SetStringField("status", "error");
-        Response->SetStringField("message", TEXT("Invalid JSON format"));
-        SendResponse(ClientSocket, Response);
+        SendResponse(Context, MCPJsonKeys::MakeErrorResponse(TEXT("Missing 'type' field")));
     }
+    return true;
+}
+
+bool FMCPTCPServer::ExecuteCommand(const FMCPDispatchTable::FEntry& Entry, const TSharedPtr<FJsonObject>& Command, const FMCPRequestContext& Context)
+{
+    MCP_LOG_INFO("Processing command: %s", *Entry.Name);
+    TGuardValue<const FMCPRequestContext*> ExecutingGuard(ExecutingRequest, &Context);
+    
+    TSharedPtr<FJsonObject> Params;
+    if (!MCPJsonKeys::Params.TryGetObject(*Command, Params))
+    {
+        Params = MakeShared<FJsonObject>();
+    }
+    
+    // Charge the command against the client's rate limit before doing any of its work
+    double RetryAfterSeconds = 0.0;
+    if (Context.Admission.IsValid() && !Context.Admission->TryCharge(Entry.Handler->GetCost(Params), RetryAfterSeconds))
+    {
+        MCP_LOG_WARNING("Rate limit exceeded for command %s, retry in %.0f ms", *Entry.Name, RetryAfterSeconds * 1000.0);
+        BusyResponseCount.fetch_add(1, std::memory_order_relaxed);
+        SendResponse(Context, MCPJsonKeys::MakeBusyResponse(TEXT("Rate limit exceeded"), RetryAfterSeconds));
+        return true;
+    }
+    
+    // Large results can be sent incrementally to clients that ask for it
+    bool bStream = false;
+    if (MCPJsonKeys::Stream.TryGetBool(*Command, bStream) && bStream && Entry.Handler->SupportsStreaming())
+    {
+        FMCPActiveStream Active;
+        Active.Stream = MakeShared<FMCPResponseStream>(*this, Context);
+        Active.Stats = Entry.Stats;
+        
+        const double StartTime = FPlatformTime::Seconds();
+        Active.Producer = Entry.Handler->BeginStreaming(Params, *Active.Stream);
+        Active.ExecutionSeconds = FPlatformTime::Seconds() - StartTime;
+        
+        if (Active.Producer.IsValid() && !Active.Stream->IsFinished())
+        {
+            ActiveStreams.Add(MoveTemp(Active));
+            return false;
+        }
+        
+        // Always terminate the stream so the client stops waiting for frames
+        if (!Active.Stream->IsFinished())
+        {
+            Active.Stream->End();
+        }
+        Entry.Stats->Record(Active.ExecutionSeconds);
+        return true;
+    }
+    
+    const FMCPCommandTraits& Traits = Entry.Traits;
+    if (Traits.IsCacheable())
+    {
+        if (TSharedPtr<FJsonObject> Cached = ResponseCache.Find(Entry.Name, Params, FPlatformTime::Seconds()))
+        {
+            SendResponse(Context, Cached);
+            return true;
+        }
+    }
+    
+    // Handle the command and get the response
+    TSharedPtr<FJsonObject> Response = Entry.Execute(Params, Context.ClientSocket);
     
-    // Keep the connection open for future commands
-    // Do not close the socket here
+    FString Status;
+    if (!Traits.bReadOnly)
+    {
+        // The command may have changed anything a cached query reported
+        ResponseCache.Invalidate();
+    }
+    else if (Traits.IsCacheable() && Response.IsValid() && MCPJsonKeys::Status.TryGetString(*Response, Status) && Status == TEXT("success"))
+    {
+        ResponseCache.Add(Entry.Name, Params, Response.ToSharedRef(), FPlatformTime::Seconds() + Traits.CacheSeconds);
+    }
+    
+    // Send the response
+    SendResponse(Context, Response);
+    return true;
+}
+
+bool FMCPTCPServer::StepStream(FMCPActiveStream& Active)
+{
+    const TSharedPtr<FMCPClientAdmission>& Admission = Active.Stream->GetContext().Admission;
+    if (Admission.IsValid())
+    {
+        if (Admission->IsClosed())
+        {
+            MCP_LOG_INFO("Abandoning response stream for a client that has disconnected");
+            Active.Stats->Record(Active.ExecutionSeconds);
+            return true;
+        }
+        
+        // Produce no more than the client can absorb, so a huge result never sits in memory all at once
+        if (Admission->GetUnsentBytes() > MCPConstants::STREAM_MAX_UNSENT_BYTES)
+        {
+            return false;
+        }
+    }
+    
+    const double StartTime = FPlatformTime::Seconds();
+    {
+        FMemMark StepMark(FMemStack::Get());
+        Active.Producer->Step(*Active.Stream);
+    }
+    Active.ExecutionSeconds += FPlatformTime::Seconds() - StartTime;
+    
+    if (!Active.Stream->IsFinished())
+    {
+        return false;
+    }
+    
+    Active.Stats->Record(Active.ExecutionSeconds);
+    return true;
+}
+
+void FMCPTCPServer::LaunchWorkerCommand(TSharedRef<const FMCPDispatchTable> Table, const FMCPDispatchTable::FEntry& Entry, TSharedPtr<FJsonObject> Command, FMCPRequestContext Context)
+{
+    const UE::Tasks::ETaskPriority TaskPriority = Entry.Traits.Priority == EMCPCommandPriority::Low
+        ? UE::Tasks::ETaskPriority::BackgroundNormal
+        : UE::Tasks::ETaskPriority::Normal;
+    
+    NumWorkerCommands.fetch_add(1, std::memory_order_relaxed);
+    WorkerTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [this, Table = MoveTemp(Table), EntryPtr = &Entry, Command = MoveTemp(Command), Context = MoveTemp(Context)]()
+        {
+            {
+                // Worker threads have their own FMemStack, released the same way as on the game thread
+                FMemMark RequestMark(FMemStack::Get());
+                ExecuteCommand(*EntryPtr, Command, Context);
+            }
+            FinishRequest(Context);
+            NumWorkerCommands.fetch_sub(1, std::memory_order_relaxed);
+        },
+        TaskPriority));
 }
 
 void FMCPTCPServer::SendResponse(FSocket* Client, const TSharedPtr<FJsonObject>& Response)
 {
     if (!Client) return;
     
-    FString ResponseStr;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseStr);
-    FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
+    // The I/O thread resolves the socket to its connection
+    FMCPRequestContext Context;
+    Context.ClientSocket = Client;
+    SendResponse(Context, Response);
+}
+
+void FMCPTCPServer::SendResponse(const FMCPRequestContext& Context, const TSharedPtr<FJsonObject>& Response)
+{
+    if (!Context.ClientSocket || !Response.IsValid()) return;
     
-    if (Config.bEnableVerboseLogging)
+    if (Context.RequestId.IsValid())
     {
-        MCP_LOG_VERBOSE("Preparing to send response: %s", *ResponseStr);
+        MCPJsonKeys::Id.Set(*Response, Context.RequestId);
     }
     
-    FTCHARToUTF8 Converter(*ResponseStr);
-    int32 BytesSent = 0;
-    int32 TotalBytes = Converter.Length();
-    const uint8* Data = (const uint8*)Converter.Get();
+    FMCPPendingResponse Pending;
+    Pending.Connection = Context.Connection;
+    Pending.ClientSocket = Context.ClientSocket;
+    Pending.Admission = Context.Admission;
+    
+    if (Context.Encoding == EMCPWireEncoding::Cbor)
+    {
+        FMCPWireCodec::EncodeCbor(Response.ToSharedRef(), Pending.Payload);
+        
+        if (Config.bEnableVerboseLogging)
+        {
+            MCP_LOG_VERBOSE("Preparing to send CBOR response (%d bytes)", Pending.Payload.Num());
+        }
+    }
+    else
+    {
+        // Written straight into the payload that is handed to the I/O thread and queued for sending,
+        // on a single line for newline-delimited clients
+        FMCPWireCodec::EncodeJson(Response.ToSharedRef(), Pending.Payload);
+        
+        if (Config.bEnableVerboseLogging)
+        {
+            FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Pending.Payload.GetData()), Pending.Payload.Num());
+            MCP_LOG_VERBOSE("Preparing to send response: %s", *FString(Converter.Length(), Converter.Get()));
+        }
+    }
     
-    // Ensure all data is sent
-    while (BytesSent < TotalBytes)
+    // Counted until the I/O thread takes it, so streams can tell how far behind their client is
+    if (Pending.Admission.IsValid())
     {
+        Pending.Admission->AddPendingResponseBytes(Pending.Payload.Num());
+    }
+    PendingResponses.Enqueue(MoveTemp(Pending));
+    
+    // Wake the I/O thread so the response goes out without waiting for the next poll
+    WakeIOThread();
+}
+
+bool FMCPTCPServer::EnableResponseCompression(const FMCPRequestContext& Context)
+{
+    if (!Context.ClientSocket || !Context.bLengthPrefixed || Config.CompressionThreshold <= 0) return false;
+    
+    // Ride the response queue so the switch lands between the responses sent before and after it;
+    // the handle keeps it from reaching a later connection that reuses the socket
+    FMCPPendingResponse Pending;
+    Pending.Connection = Context.Connection;
+    Pending.ClientSocket = Context.ClientSocket;
+    Pending.bEnableCompression = true;
+    PendingResponses.Enqueue(MoveTemp(Pending));
+    
+    WakeIOThread();
+    return true;
+}
+
+void FMCPTCPServer::ProcessPendingResponses()
+{
+    FMCPPendingResponse Pending;
+    while (PendingResponses.Dequeue(Pending))
+    {
+        if (Pending.Admission.IsValid())
+        {
+            Pending.Admission->AddPendingResponseBytes(-Pending.Payload.Num());
+        }
+        
+        FMCPConnectionHandle Handle = Pending.Connection;
+        if (!Handle.IsSet())
+        {
+            Handle = SocketConnections.FindRef(Pending.ClientSocket);
+        }
+        
+        // The client may have disconnected while its command was executing
+        FMCPClientConnection* Connection = ClientConnections.Find(Handle);
+        
+        if (!Connection)
+        {
+            MCP_LOG_VERBOSE("Dropping response for a client that has disconnected");
+            continue;
+        }
+        
+        if (Pending.bEnableCompression)
+        {
+            Connection->Framer.SetCompressionThreshold(Config.CompressionThreshold);
+        }
+        
+        if (Pending.Payload.Num() == 0)
+        {
+            continue;
+        }
+        
+        Connection->Framer.FrameOutgoing(Pending.Payload);
+        if (!Connection->HasPendingOutbound())
+        {
+            // The write deadline runs from when the client first has something to read
+            Connection->LastWriteProgressTime = FPlatformTime::Seconds();
+        }
+        Connection->OutboundBytes += Pending.Payload.Num();
+        Connection->OutboundQueue.Add(MoveTemp(Pending.Payload));
+        
+        // Write straight away; anything the socket does not take is resumed when it becomes writable
+        if (!FlushOutbound(*Connection))
+        {
+            CleanupClientConnection(*Connection);
+        }
+    }
+}
+
+void FMCPTCPServer::FlushAllOutbound()
+{
+    for (TMCPSlotMap<FMCPClientConnection>::TIterator It = ClientConnections.CreateIterator(); It; ++It)
+    {
+        FMCPClientConnection& ClientConnection = *It;
+        if (ClientConnection.Socket && ClientConnection.HasPendingOutbound() && !FlushOutbound(ClientConnection))
+        {
+            CleanupClientConnection(ClientConnection);
+        }
+    }
+}
+
+bool FMCPTCPServer::FlushOutbound(FMCPClientConnection& ClientConnection)
+{
+    while (ClientConnection.HasPendingOutbound())
+    {
+        const TArray<uint8>& Front = ClientConnection.OutboundQueue[0];
+        const int32 Remaining = Front.Num() - ClientConnection.OutboundOffset;
+        
         int32 SentThisTime = 0;
-        if (!Client->Send(Data + BytesSent, TotalBytes - BytesSent, SentThisTime))
+        if (!ClientConnection.Socket->Send(Front.GetData() + ClientConnection.OutboundOffset, Remaining, SentThisTime))
         {
-            MCP_LOG_WARNING("Failed to send response");
-            break;
+            int32 ErrorCode = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+            if (ErrorCode == SE_EWOULDBLOCK)
+            {
+                break;
+            }
+            
+            MCP_LOG_WARNING("Socket error %d while sending to client %s, closing connection", 
+                ErrorCode, *ClientConnection.Endpoint.ToString());
+            return false;
         }
         
         if (SentThisTime <= 0)
         {
-            // Would block, try again next tick
-            MCP_LOG_VERBOSE("Socket would block, will try again next tick");
+            // Socket buffer is full, resume once it drains
             break;
         }
         
-        BytesSent += SentThisTime;
+        ClientConnection.OutboundOffset += SentThisTime;
+        ClientConnection.OutboundBytes -= SentThisTime;
+        ClientConnection.LastActivityTime = FPlatformTime::Seconds();
+        ClientConnection.LastWriteProgressTime = ClientConnection.LastActivityTime;
         
         if (Config.bEnableVerboseLogging)
         {
-            MCP_LOG_VERBOSE("Sent %d/%d bytes", BytesSent, TotalBytes);
+            MCP_LOG_VERBOSE("Sent %d/%d bytes to client %s", ClientConnection.OutboundOffset, Front.Num(), *ClientConnection.Endpoint.ToString());
+        }
+        
+        if (ClientConnection.OutboundOffset == Front.Num())
+        {
+            MCP_LOG_INFO("Successfully sent complete response (%d bytes)", Front.Num());
+            ClientConnection.OutboundQueue.RemoveAt(0, 1, EAllowShrinking::No);
+            ClientConnection.OutboundOffset = 0;
         }
     }
     
-    if (BytesSent == TotalBytes)
+    if (ClientConnection.Admission.IsValid())
     {
-        MCP_LOG_INFO("Successfully sent complete response (%d bytes)", TotalBytes);
+        ClientConnection.Admission->SetOutboundBytes(ClientConnection.OutboundBytes);
     }
-    else
+    
+    // Only watch for writability while there is something left to write
+    const bool bWantsWrite = ClientConnection.HasPendingOutbound();
+    if (bWantsWrite != ClientConnection.bWantsWrite)
+    {
+        ClientConnection.bWantsWrite = bWantsWrite;
+        Poller->SetWantsWrite(ClientConnection.Socket, ClientConnection.Handle, bWantsWrite);
+    }
+    
+    if (!bWantsWrite)
     {
-        MCP_LOG_WARNING("Only sent %d/%d bytes of response", BytesSent, TotalBytes);
+        ClientConnection.LastWriteProgressTime = 0.0;
     }
+    UpdateConnectionDeadline(ClientConnection);
+    
+    return true;
 }
 
 FString FMCPTCPServer::GetSafeSocketDescription(FSocket* Socket)
@@ -0,0 +1,107 @@
+#include "MCPUnixSocketListener.h"
+#include "MCPFileLogger.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#if MCP_WITH_UNIX_SOCKETS
+#include "BSDSockets/SocketsBSD.h"
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <errno.h>
+
+namespace
+{
+    bool MakeAddress(const FString& Path, sockaddr_un& OutAddress)
+    {
+        FTCHARToUTF8 PathUtf8(*Path);
+
+        FMemory::Memzero(OutAddress);
+        OutAddress.sun_family = AF_UNIX;
+        if (PathUtf8.Length() <= 0 || PathUtf8.Length() >= int32(sizeof(OutAddress.sun_path)))
+        {
+            return false;
+        }
+
+        FMemory::Memcpy(OutAddress.sun_path, PathUtf8.Get(), PathUtf8.Length());
+        return true;
+    }
+
+    /** Check whether another server is accepting on the socket file */
+    bool IsPathInUse(const sockaddr_un& Address)
+    {
+        const int Probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (Probe < 0)
+        {
+            return false;
+        }
+
+        const bool bInUse = connect(Probe, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) == 0;
+        close(Probe);
+        return bInUse;
+    }
+}
+#endif
+
+FSocket* FMCPUnixSocketListener::Create(const FString& Path, int32 Backlog)
+{
+#if MCP_WITH_UNIX_SOCKETS
+    sockaddr_un Address;
+    if (!MakeAddress(Path, Address))
+    {
+        MCP_LOG_ERROR("Unix socket path is empty or too long: %s", *Path);
+        return nullptr;
+    }
+
+    if (IsPathInUse(Address))
+    {
+        MCP_LOG_ERROR("Unix socket %s is already in use by another server", *Path);
+        return nullptr;
+    }
+
+    // Nothing is listening, so any existing file is left over from an editor that did not shut down cleanly
+    unlink(Address.sun_path);
+
+    const int Fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (Fd < 0)
+    {
+        MCP_LOG_ERROR("Failed to create Unix socket (errno %d)", errno);
+        return nullptr;
+    }
+
+    if (bind(Fd, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0 || listen(Fd, Backlog) != 0)
+    {
+        MCP_LOG_ERROR("Failed to listen on Unix socket %s (errno %d)", *Path, errno);
+        close(Fd);
+        return nullptr;
+    }
+
+    // Commands can run arbitrary Python in the editor, so only the editor's user may connect
+    chmod(Address.sun_path, S_IRUSR | S_IWUSR);
+
+    return new FSocketBSD(Fd, SOCKTYPE_Streaming, TEXT("MCPUnixListener"), NAME_None, ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM));
+#else
+    MCP_LOG_WARNING("Unix socket listeners are not supported on this platform");
+    return nullptr;
+#endif
+}
+
+void FMCPUnixSocketListener::Destroy(FSocket* Socket, const FString& Path)
+{
+    if (!Socket)
+    {
+        return;
+    }
+
+    Socket->Close();
+    ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+
+#if MCP_WITH_UNIX_SOCKETS
+    sockaddr_un Address;
+    if (MakeAddress(Path, Address))
+    {
+        unlink(Address.sun_path);
+    }
+#endif
+}
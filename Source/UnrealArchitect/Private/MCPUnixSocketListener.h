@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSocket;
+
+/**
+ * Creates the optional Unix domain socket listener for same-host clients
+ * The listener is a regular FSocket, so accepted connections go through the same
+ * framing, polling and dispatch as TCP clients. Only available where the engine uses
+ * BSD sockets (MCP_WITH_UNIX_SOCKETS); elsewhere Create always fails.
+ */
+class FMCPUnixSocketListener
+{
+public:
+    /**
+     * Bind and listen on a socket file, replacing a stale file left behind by a crashed editor
+     * @param Path - Filesystem path of the socket
+     * @param Backlog - Listen backlog
+     * @return The non-blocking listening socket, or nullptr on failure or if the path is in use
+     */
+    static FSocket* Create(const FString& Path, int32 Backlog);
+
+    /**
+     * Close the listener and remove its socket file
+     * @param Socket - The listening socket returned by Create
+     * @param Path - The path it was created with
+     */
+    static void Destroy(FSocket* Socket, const FString& Path);
+};
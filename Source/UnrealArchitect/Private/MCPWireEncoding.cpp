@@ -0,0 +1,1665 @@
+#include "MCPWireEncoding.h"
+#include "MCPJsonStructuralIndex.h"
+#include "Dom/JsonValue.h"
+#include "Misc/Base64.h"
+#include "Misc/MemStack.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    /** CBOR major types, stored in the top three bits of each initial byte */
+    enum class ECborMajorType : uint8
+    {
+        Unsigned = 0,
+        Negative = 1,
+        Bytes = 2,
+        Text = 3,
+        Array = 4,
+        Map = 5,
+        Tag = 6,
+        Simple = 7
+    };
+
+    /** Additional-information value marking an indefinite-length item */
+    constexpr uint8 CBOR_INDEFINITE = 31;
+
+    /** Terminates an indefinite-length array or map */
+    constexpr uint8 CBOR_BREAK = 0xFF;
+
+    constexpr uint8 CBOR_FALSE = 0xF4;
+    constexpr uint8 CBOR_TRUE = 0xF5;
+    constexpr uint8 CBOR_NULL = 0xF6;
+    constexpr uint8 CBOR_FLOAT32 = 0xFA;
+    constexpr uint8 CBOR_FLOAT64 = 0xFB;
+
+    /** Deepest nesting accepted before a payload is rejected, so hostile input cannot exhaust the stack */
+    constexpr int32 MAX_NESTING_DEPTH = 128;
+
+    /** Largest magnitude below which every integer is exactly representable as a double */
+    constexpr double MAX_EXACT_INTEGER = 9007199254740992.0;
+
+    /** Integers from 0 up to this value share one preallocated JSON value each */
+    constexpr int32 NUM_SHARED_INTEGERS = 256;
+
+    /**
+     * Immutable JSON values shared by every decoded request
+     * Booleans, nulls and small integers (counts, indices, unit scales) make up much of a typical
+     * request, and since JSON values are never modified in place, one instance of each can be
+     * referenced everywhere instead of allocating a node per occurrence.
+     */
+    struct FSharedJsonValues
+    {
+        static const FSharedJsonValues& Get()
+        {
+            static const FSharedJsonValues Values;
+            return Values;
+        }
+
+        TSharedPtr<FJsonValue> MakeNumber(double Number) const
+        {
+            if (Number >= 0.0 && Number < NUM_SHARED_INTEGERS && Number == FMath::TruncToDouble(Number) && !(Number == 0.0 && std::signbit(Number)))
+            {
+                return Integers[static_cast<int32>(Number)];
+            }
+            return MakeShared<FJsonValueNumber>(Number);
+        }
+
+        TSharedPtr<FJsonValue> True = MakeShared<FJsonValueBoolean>(true);
+        TSharedPtr<FJsonValue> False = MakeShared<FJsonValueBoolean>(false);
+        TSharedPtr<FJsonValue> Null = MakeShared<FJsonValueNull>();
+
+    private:
+        FSharedJsonValues()
+        {
+            for (int32 Index = 0; Index < NUM_SHARED_INTEGERS; ++Index)
+            {
+                Integers[Index] = MakeShared<FJsonValueNumber>(Index);
+            }
+        }
+
+        TSharedPtr<FJsonValue> Integers[NUM_SHARED_INTEGERS];
+    };
+
+    /**
+     * Move decoded elements out of request-scoped scratch into a heap array allocated once at its final size
+     * @param Scratch - Elements collected on the FMemStack while their count was unknown
+     * @return The elements
+     */
+    TArray<TSharedPtr<FJsonValue>> MoveToHeap(TArray<TSharedPtr<FJsonValue>, TMemStackAllocator<>>& Scratch)
+    {
+        TArray<TSharedPtr<FJsonValue>> Elements;
+        Elements.Reserve(Scratch.Num());
+        for (TSharedPtr<FJsonValue>& Element : Scratch)
+        {
+            Elements.Add(MoveTemp(Element));
+        }
+        return Elements;
+    }
+
+    /**
+     * Reads a CBOR item tree into JSON values
+     * Every read is bounds-checked; any malformed input fails the whole decode
+     */
+    class FCborDecoder
+    {
+    public:
+        FCborDecoder(const uint8* InData, int32 InNum)
+            : Data(InData)
+            , Num(InNum)
+            , Offset(0)
+        {
+        }
+
+        bool ReadValue(TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            if (Depth > MAX_NESTING_DEPTH)
+            {
+                return false;
+            }
+
+            uint8 Initial;
+            if (!ReadByte(Initial))
+            {
+                return false;
+            }
+
+            const ECborMajorType Major = static_cast<ECborMajorType>(Initial >> 5);
+            const uint8 Info = Initial & 0x1F;
+
+            if (Major == ECborMajorType::Simple)
+            {
+                return ReadSimple(Info, OutValue);
+            }
+
+            if (Info == CBOR_INDEFINITE)
+            {
+                switch (Major)
+                {
+                case ECborMajorType::Array:
+                    return ReadArray(0, true, OutValue, Depth);
+                case ECborMajorType::Map:
+                    return ReadMap(0, true, OutValue, Depth);
+                default:
+                    // Chunked strings are legal CBOR but no client needs them
+                    return false;
+                }
+            }
+
+            uint64 Argument;
+            if (!ReadArgument(Info, Argument))
+            {
+                return false;
+            }
+
+            switch (Major)
+            {
+            case ECborMajorType::Unsigned:
+                OutValue = FSharedJsonValues::Get().MakeNumber(static_cast<double>(Argument));
+                return true;
+
+            case ECborMajorType::Negative:
+                OutValue = MakeShared<FJsonValueNumber>(-1.0 - static_cast<double>(Argument));
+                return true;
+
+            case ECborMajorType::Bytes:
+                if (Argument > static_cast<uint64>(Num - Offset))
+                {
+                    return false;
+                }
+                // JSON has no binary type, so byte strings reach handlers as base64 text
+                OutValue = MakeShared<FJsonValueString>(FBase64::Encode(Data + Offset, static_cast<uint32>(Argument)));
+                Offset += static_cast<int32>(Argument);
+                return true;
+
+            case ECborMajorType::Text:
+                {
+                    FString Text;
+                    if (!ReadText(Argument, Text))
+                    {
+                        return false;
+                    }
+                    OutValue = MakeShared<FJsonValueString>(MoveTemp(Text));
+                    return true;
+                }
+
+            case ECborMajorType::Array:
+                return ReadArray(Argument, false, OutValue, Depth);
+
+            case ECborMajorType::Map:
+                return ReadMap(Argument, false, OutValue, Depth);
+
+            case ECborMajorType::Tag:
+                // Tags carry semantic hints with no JSON equivalent; decode the tagged item as-is
+                return ReadValue(OutValue, Depth + 1);
+
+            default:
+                return false;
+            }
+        }
+
+        bool AtEnd() const
+        {
+            return Offset == Num;
+        }
+
+        /**
+         * Decode one scalar member of the top-level map, stepping over every other member unread
+         * @param Name - The key to look for
+         * @param OutValue - The member's value
+         * @return True if the item is a map and the member was found with a non-container value
+         */
+        bool FindScalarMember(const TCHAR* Name, TSharedPtr<FJsonValue>& OutValue)
+        {
+            uint8 Initial;
+            if (!ReadByte(Initial) || static_cast<ECborMajorType>(Initial >> 5) != ECborMajorType::Map)
+            {
+                return false;
+            }
+
+            const bool bIndefinite = (Initial & 0x1F) == CBOR_INDEFINITE;
+            uint64 Count = 0;
+            if (!bIndefinite && !ReadArgument(Initial & 0x1F, Count))
+            {
+                return false;
+            }
+
+            for (uint64 Index = 0; bIndefinite || Index < Count; ++Index)
+            {
+                if (bIndefinite && TryReadBreak())
+                {
+                    break;
+                }
+
+                FString Key;
+                if (!ReadKey(Key))
+                {
+                    return false;
+                }
+
+                if (Key == Name)
+                {
+                    if (Offset >= Num)
+                    {
+                        return false;
+                    }
+                    const ECborMajorType Major = static_cast<ECborMajorType>(Data[Offset] >> 5);
+                    return Major != ECborMajorType::Array && Major != ECborMajorType::Map && ReadValue(OutValue, 1);
+                }
+
+                if (!SkipValue(1))
+                {
+                    return false;
+                }
+            }
+
+            return false;
+        }
+
+    private:
+        /** Step over one item without building anything; as strict as ReadValue about bounds */
+        bool SkipValue(int32 Depth)
+        {
+            if (Depth > MAX_NESTING_DEPTH)
+            {
+                return false;
+            }
+
+            uint8 Initial;
+            if (!ReadByte(Initial))
+            {
+                return false;
+            }
+
+            const ECborMajorType Major = static_cast<ECborMajorType>(Initial >> 5);
+            const uint8 Info = Initial & 0x1F;
+
+            if (Major == ECborMajorType::Simple)
+            {
+                uint64 Bits;
+                switch (Info)
+                {
+                case 24: return ReadBigEndian(1, Bits);
+                case 25: return ReadBigEndian(2, Bits);
+                case 26: return ReadBigEndian(4, Bits);
+                case 27: return ReadBigEndian(8, Bits);
+                default: return Info < 24;
+                }
+            }
+
+            if (Info == CBOR_INDEFINITE)
+            {
+                if (Major != ECborMajorType::Array && Major != ECborMajorType::Map)
+                {
+                    return false;
+                }
+
+                // Keys and values are both plain items, so a map skips like an array of pairs
+                while (!TryReadBreak())
+                {
+                    if (!SkipValue(Depth + 1))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            uint64 Argument;
+            if (!ReadArgument(Info, Argument))
+            {
+                return false;
+            }
+
+            switch (Major)
+            {
+            case ECborMajorType::Unsigned:
+            case ECborMajorType::Negative:
+                return true;
+
+            case ECborMajorType::Bytes:
+            case ECborMajorType::Text:
+                if (Argument > static_cast<uint64>(Num - Offset))
+                {
+                    return false;
+                }
+                Offset += static_cast<int32>(Argument);
+                return true;
+
+            case ECborMajorType::Map:
+                if (Argument > static_cast<uint64>(Num - Offset) / 2)
+                {
+                    return false;
+                }
+                // Skip the pairs as plain items
+                Argument *= 2;
+                [[fallthrough]];
+            case ECborMajorType::Array:
+                if (Argument > static_cast<uint64>(Num - Offset))
+                {
+                    return false;
+                }
+                for (uint64 Index = 0; Index < Argument; ++Index)
+                {
+                    if (!SkipValue(Depth + 1))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+
+            case ECborMajorType::Tag:
+                return SkipValue(Depth + 1);
+
+            default:
+                return false;
+            }
+        }
+
+        bool ReadByte(uint8& OutByte)
+        {
+            if (Offset >= Num)
+            {
+                return false;
+            }
+            OutByte = Data[Offset++];
+            return true;
+        }
+
+        bool ReadBigEndian(int32 NumBytes, uint64& OutValue)
+        {
+            if (Num - Offset < NumBytes)
+            {
+                return false;
+            }
+
+            OutValue = 0;
+            for (int32 Index = 0; Index < NumBytes; ++Index)
+            {
+                OutValue = (OutValue << 8) | Data[Offset++];
+            }
+            return true;
+        }
+
+        bool ReadArgument(uint8 Info, uint64& OutValue)
+        {
+            if (Info < 24)
+            {
+                OutValue = Info;
+                return true;
+            }
+
+            switch (Info)
+            {
+            case 24: return ReadBigEndian(1, OutValue);
+            case 25: return ReadBigEndian(2, OutValue);
+            case 26: return ReadBigEndian(4, OutValue);
+            case 27: return ReadBigEndian(8, OutValue);
+            default: return false;
+            }
+        }
+
+        bool ReadText(uint64 Length, FString& OutText)
+        {
+            if (Length > static_cast<uint64>(Num - Offset))
+            {
+                return false;
+            }
+
+            FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data + Offset), static_cast<int32>(Length));
+            OutText = FString(Converter.Length(), Converter.Get());
+            Offset += static_cast<int32>(Length);
+            return true;
+        }
+
+        /** Read a map key straight into a string; JSON objects only have definite-length text keys */
+        bool ReadKey(FString& OutKey)
+        {
+            uint8 Initial;
+            uint64 Length;
+            return ReadByte(Initial)
+                && static_cast<ECborMajorType>(Initial >> 5) == ECborMajorType::Text
+                && ReadArgument(Initial & 0x1F, Length)
+                && ReadText(Length, OutKey);
+        }
+
+        bool ReadSimple(uint8 Info, TSharedPtr<FJsonValue>& OutValue)
+        {
+            uint64 Bits;
+            switch (Info)
+            {
+            case CBOR_FALSE & 0x1F:
+                OutValue = FSharedJsonValues::Get().False;
+                return true;
+
+            case CBOR_TRUE & 0x1F:
+                OutValue = FSharedJsonValues::Get().True;
+                return true;
+
+            case CBOR_NULL & 0x1F:
+            case 23: // undefined
+                OutValue = FSharedJsonValues::Get().Null;
+                return true;
+
+            case 25:
+                if (!ReadBigEndian(2, Bits))
+                {
+                    return false;
+                }
+                OutValue = MakeShared<FJsonValueNumber>(DecodeHalf(static_cast<uint16>(Bits)));
+                return true;
+
+            case CBOR_FLOAT32 & 0x1F:
+                {
+                    if (!ReadBigEndian(4, Bits))
+                    {
+                        return false;
+                    }
+                    const uint32 Bits32 = static_cast<uint32>(Bits);
+                    float Value;
+                    FMemory::Memcpy(&Value, &Bits32, sizeof(Value));
+                    OutValue = FSharedJsonValues::Get().MakeNumber(Value);
+                    return true;
+                }
+
+            case CBOR_FLOAT64 & 0x1F:
+                {
+                    if (!ReadBigEndian(8, Bits))
+                    {
+                        return false;
+                    }
+                    double Value;
+                    FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+                    OutValue = FSharedJsonValues::Get().MakeNumber(Value);
+                    return true;
+                }
+
+            default:
+                // A stray break, or a simple value with no JSON meaning
+                return false;
+            }
+        }
+
+        static double DecodeHalf(uint16 Half)
+        {
+            const int32 Exponent = (Half >> 10) & 0x1F;
+            const int32 Mantissa = Half & 0x3FF;
+
+            double Value;
+            if (Exponent == 0)
+            {
+                Value = std::ldexp(static_cast<double>(Mantissa), -24);
+            }
+            else if (Exponent != 31)
+            {
+                Value = std::ldexp(static_cast<double>(Mantissa + 1024), Exponent - 25);
+            }
+            else
+            {
+                Value = Mantissa == 0 ? INFINITY : NAN;
+            }
+
+            return (Half & 0x8000) ? -Value : Value;
+        }
+
+        /** Consume the break byte that ends an indefinite-length container, if it is next */
+        bool TryReadBreak()
+        {
+            if (Offset < Num && Data[Offset] == CBOR_BREAK)
+            {
+                ++Offset;
+                return true;
+            }
+            return false;
+        }
+
+        bool ReadArray(uint64 Count, bool bIndefinite, TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            // Every element takes at least one byte, which bounds the reservation for hostile counts
+            if (!bIndefinite && Count > static_cast<uint64>(Num - Offset))
+            {
+                return false;
+            }
+
+            if (bIndefinite)
+            {
+                TArray<TSharedPtr<FJsonValue>, TMemStackAllocator<>> Scratch;
+                while (!TryReadBreak())
+                {
+                    TSharedPtr<FJsonValue> Element;
+                    if (!ReadValue(Element, Depth + 1))
+                    {
+                        return false;
+                    }
+                    Scratch.Add(MoveTemp(Element));
+                }
+
+                OutValue = MakeShared<FJsonValueArray>(MoveToHeap(Scratch));
+                return true;
+            }
+
+            TArray<TSharedPtr<FJsonValue>> Elements;
+            Elements.Reserve(static_cast<int32>(Count));
+
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                TSharedPtr<FJsonValue> Element;
+                if (!ReadValue(Element, Depth + 1))
+                {
+                    return false;
+                }
+                Elements.Add(MoveTemp(Element));
+            }
+
+            OutValue = MakeShared<FJsonValueArray>(MoveTemp(Elements));
+            return true;
+        }
+
+        bool ReadMap(uint64 Count, bool bIndefinite, TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            if (!bIndefinite && Count > static_cast<uint64>(Num - Offset) / 2)
+            {
+                return false;
+            }
+
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            if (!bIndefinite)
+            {
+                Object->Values.Reserve(static_cast<int32>(Count));
+            }
+
+            for (uint64 Index = 0; bIndefinite || Index < Count; ++Index)
+            {
+                if (bIndefinite && TryReadBreak())
+                {
+                    break;
+                }
+
+                FString Key;
+                if (!ReadKey(Key))
+                {
+                    return false;
+                }
+
+                TSharedPtr<FJsonValue> Value;
+                if (!ReadValue(Value, Depth + 1))
+                {
+                    return false;
+                }
+                Object->Values.Add(MoveTemp(Key), MoveTemp(Value));
+            }
+
+            OutValue = MakeShared<FJsonValueObject>(Object);
+            return true;
+        }
+
+        const uint8* Data;
+        int32 Num;
+        int32 Offset;
+    };
+
+    /**
+     * Writes JSON values as CBOR using the shortest encoding for each item
+     * Integral numbers become CBOR integers and other numbers use single precision when
+     * that is lossless, which is what makes numeric-heavy payloads compact
+     */
+    class FCborEncoder
+    {
+    public:
+        explicit FCborEncoder(TArray<uint8>& InOut)
+            : Out(InOut)
+        {
+        }
+
+        void WriteObject(const TSharedRef<FJsonObject>& Object)
+        {
+            WriteHeader(ECborMajorType::Map, Object->Values.Num());
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values)
+            {
+                WriteText(Pair.Key);
+                WriteValue(Pair.Value);
+            }
+        }
+
+        void WriteValue(const TSharedPtr<FJsonValue>& Value)
+        {
+            if (!Value.IsValid())
+            {
+                Out.Add(CBOR_NULL);
+                return;
+            }
+
+            switch (Value->Type)
+            {
+            case EJson::String:
+                WriteText(Value->AsString());
+                break;
+
+            case EJson::Number:
+                WriteNumber(Value->AsNumber());
+                break;
+
+            case EJson::Boolean:
+                Out.Add(Value->AsBool() ? CBOR_TRUE : CBOR_FALSE);
+                break;
+
+            case EJson::Array:
+                {
+                    const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+                    WriteHeader(ECborMajorType::Array, Elements.Num());
+                    for (const TSharedPtr<FJsonValue>& Element : Elements)
+                    {
+                        WriteValue(Element);
+                    }
+                    break;
+                }
+
+            case EJson::Object:
+                {
+                    const TSharedPtr<FJsonObject> Object = Value->AsObject();
+                    if (Object.IsValid())
+                    {
+                        WriteObject(Object.ToSharedRef());
+                    }
+                    else
+                    {
+                        Out.Add(CBOR_NULL);
+                    }
+                    break;
+                }
+
+            default:
+                Out.Add(CBOR_NULL);
+                break;
+            }
+        }
+
+    private:
+        void WriteBigEndian(uint64 Value, int32 NumBytes)
+        {
+            for (int32 Index = NumBytes - 1; Index >= 0; --Index)
+            {
+                Out.Add(static_cast<uint8>(Value >> (Index * 8)));
+            }
+        }
+
+        void WriteHeader(ECborMajorType Major, uint64 Argument)
+        {
+            const uint8 Type = static_cast<uint8>(Major) << 5;
+            if (Argument < 24)
+            {
+                Out.Add(Type | static_cast<uint8>(Argument));
+            }
+            else if (Argument <= MAX_uint8)
+            {
+                Out.Add(Type | 24);
+                WriteBigEndian(Argument, 1);
+            }
+            else if (Argument <= MAX_uint16)
+            {
+                Out.Add(Type | 25);
+                WriteBigEndian(Argument, 2);
+            }
+            else if (Argument <= MAX_uint32)
+            {
+                Out.Add(Type | 26);
+                WriteBigEndian(Argument, 4);
+            }
+            else
+            {
+                Out.Add(Type | 27);
+                WriteBigEndian(Argument, 8);
+            }
+        }
+
+        void WriteText(const FString& Text)
+        {
+            FTCHARToUTF8 Converter(*Text, Text.Len());
+            WriteHeader(ECborMajorType::Text, Converter.Length());
+            Out.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+        }
+
+        void WriteNumber(double Number)
+        {
+            if (FMath::IsFinite(Number) && Number == FMath::TruncToDouble(Number) && FMath::Abs(Number) < MAX_EXACT_INTEGER)
+            {
+                const int64 Integer = static_cast<int64>(Number);
+                if (Integer >= 0)
+                {
+                    WriteHeader(ECborMajorType::Unsigned, static_cast<uint64>(Integer));
+                }
+                else
+                {
+                    WriteHeader(ECborMajorType::Negative, static_cast<uint64>(-1 - Integer));
+                }
+                return;
+            }
+
+            const float Single = static_cast<float>(Number);
+            if (static_cast<double>(Single) == Number)
+            {
+                uint32 Bits;
+                FMemory::Memcpy(&Bits, &Single, sizeof(Bits));
+                Out.Add(CBOR_FLOAT32);
+                WriteBigEndian(Bits, 4);
+            }
+            else
+            {
+                uint64 Bits;
+                FMemory::Memcpy(&Bits, &Number, sizeof(Bits));
+                Out.Add(CBOR_FLOAT64);
+                WriteBigEndian(Bits, 8);
+            }
+        }
+
+        TArray<uint8>& Out;
+    };
+
+    /**
+     * Writes JSON values as condensed UTF-8 text, appending to a byte buffer
+     * Produces the bytes that go on the wire in one pass, rather than printing to an FString
+     * and converting that to UTF-8 afterwards
+     */
+    class FJsonUtf8Encoder
+    {
+    public:
+        explicit FJsonUtf8Encoder(TArray<uint8>& InOut)
+            : Out(InOut)
+        {
+        }
+
+        void WriteObject(const TSharedRef<FJsonObject>& Object)
+        {
+            Out.Add('{');
+            bool bFirst = true;
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values)
+            {
+                if (!bFirst)
+                {
+                    Out.Add(',');
+                }
+                bFirst = false;
+
+                WriteString(Pair.Key);
+                Out.Add(':');
+                WriteValue(Pair.Value);
+            }
+            Out.Add('}');
+        }
+
+        void WriteValue(const TSharedPtr<FJsonValue>& Value)
+        {
+            if (!Value.IsValid())
+            {
+                WriteAscii("null", 4);
+                return;
+            }
+
+            switch (Value->Type)
+            {
+            case EJson::String:
+                WriteString(Value->AsString());
+                break;
+
+            case EJson::Number:
+                WriteNumber(Value->AsNumber());
+                break;
+
+            case EJson::Boolean:
+                if (Value->AsBool())
+                {
+                    WriteAscii("true", 4);
+                }
+                else
+                {
+                    WriteAscii("false", 5);
+                }
+                break;
+
+            case EJson::Array:
+                {
+                    Out.Add('[');
+                    bool bFirst = true;
+                    for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+                    {
+                        if (!bFirst)
+                        {
+                            Out.Add(',');
+                        }
+                        bFirst = false;
+                        WriteValue(Element);
+                    }
+                    Out.Add(']');
+                    break;
+                }
+
+            case EJson::Object:
+                {
+                    const TSharedPtr<FJsonObject> Object = Value->AsObject();
+                    if (Object.IsValid())
+                    {
+                        WriteObject(Object.ToSharedRef());
+                    }
+                    else
+                    {
+                        WriteAscii("null", 4);
+                    }
+                    break;
+                }
+
+            default:
+                WriteAscii("null", 4);
+                break;
+            }
+        }
+
+    private:
+        void WriteAscii(const ANSICHAR* Text, int32 Length)
+        {
+            Out.Append(reinterpret_cast<const uint8*>(Text), Length);
+        }
+
+        void WriteNumber(double Number)
+        {
+            // JSON has no representation for infinities or NaN
+            if (!FMath::IsFinite(Number))
+            {
+                WriteAscii("null", 4);
+                return;
+            }
+
+            ANSICHAR Buffer[32];
+            int32 Length;
+            if (Number == FMath::TruncToDouble(Number) && FMath::Abs(Number) < MAX_EXACT_INTEGER)
+            {
+                Length = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%lld", static_cast<long long>(Number));
+            }
+            else
+            {
+                Length = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.17g", Number);
+            }
+            WriteAscii(Buffer, FMath::Clamp(Length, 0, int32(UE_ARRAY_COUNT(Buffer)) - 1));
+        }
+
+        void WriteCodePoint(uint32 CodePoint)
+        {
+            if (CodePoint < 0x800)
+            {
+                Out.Add(uint8(0xC0 | (CodePoint >> 6)));
+                Out.Add(uint8(0x80 | (CodePoint & 0x3F)));
+            }
+            else if (CodePoint < 0x10000)
+            {
+                Out.Add(uint8(0xE0 | (CodePoint >> 12)));
+                Out.Add(uint8(0x80 | ((CodePoint >> 6) & 0x3F)));
+                Out.Add(uint8(0x80 | (CodePoint & 0x3F)));
+            }
+            else
+            {
+                Out.Add(uint8(0xF0 | (CodePoint >> 18)));
+                Out.Add(uint8(0x80 | ((CodePoint >> 12) & 0x3F)));
+                Out.Add(uint8(0x80 | ((CodePoint >> 6) & 0x3F)));
+                Out.Add(uint8(0x80 | (CodePoint & 0x3F)));
+            }
+        }
+
+        void WriteString(const FString& String)
+        {
+            static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+            const TCHAR* Chars = *String;
+            const int32 Length = String.Len();
+
+            // Worst case is every character needing an escape or a multi-byte sequence; plain ASCII is the norm
+            Out.Reserve(Out.Num() + Length + 2);
+            Out.Add('"');
+
+            for (int32 Index = 0; Index < Length; ++Index)
+            {
+                uint32 CodePoint = uint32(Chars[Index]);
+                if (CodePoint >= 0x20 && CodePoint < 0x80)
+                {
+                    if (CodePoint == '"' || CodePoint == '\\')
+                    {
+                        Out.Add('\\');
+                    }
+                    Out.Add(uint8(CodePoint));
+                    continue;
+                }
+
+                switch (CodePoint)
+                {
+                case '\b': WriteAscii("\\b", 2); continue;
+                case '\f': WriteAscii("\\f", 2); continue;
+                case '\n': WriteAscii("\\n", 2); continue;
+                case '\r': WriteAscii("\\r", 2); continue;
+                case '\t': WriteAscii("\\t", 2); continue;
+                default: break;
+                }
+
+                if (CodePoint < 0x20)
+                {
+                    const ANSICHAR Escape[] = { '\\', 'u', '0', '0', HexDigits[CodePoint >> 4], HexDigits[CodePoint & 0xF] };
+                    WriteAscii(Escape, UE_ARRAY_COUNT(Escape));
+                    continue;
+                }
+
+                // Rejoin UTF-16 surrogate pairs; a lone surrogate becomes the replacement character
+                if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Index + 1 < Length
+                    && uint32(Chars[Index + 1]) >= 0xDC00 && uint32(Chars[Index + 1]) <= 0xDFFF)
+                {
+                    CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (uint32(Chars[++Index]) - 0xDC00);
+                }
+                else if ((CodePoint >= 0xD800 && CodePoint <= 0xDFFF) || CodePoint > 0x10FFFF)
+                {
+                    CodePoint = 0xFFFD;
+                }
+
+                WriteCodePoint(CodePoint);
+            }
+
+            Out.Add('"');
+        }
+
+        TArray<uint8>& Out;
+    };
+
+    /**
+     * Parses UTF-8 JSON text straight into JSON values
+     * Only string contents are converted to TCHAR, one string at a time, instead of widening
+     * the whole message into an FString and re-reading it
+     */
+    class FJsonUtf8Decoder
+    {
+    public:
+        FJsonUtf8Decoder(const uint8* InData, int32 InNum, const TArray<int32>* InStructurals = nullptr)
+            : Data(InData)
+            , Num(InNum)
+            , Offset(0)
+            , Structurals(InStructurals)
+            , Cursor(0)
+        {
+        }
+
+        bool ReadValue(TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            if (Depth > MAX_NESTING_DEPTH)
+            {
+                return false;
+            }
+
+            SkipWhitespace();
+            if (Offset >= Num)
+            {
+                return false;
+            }
+
+            switch (Data[Offset])
+            {
+            case '{':
+                {
+                    TSharedPtr<FJsonObject> Object;
+                    if (!ReadObject(Object, Depth))
+                    {
+                        return false;
+                    }
+                    OutValue = MakeShared<FJsonValueObject>(Object);
+                    return true;
+                }
+
+            case '[':
+                return ReadArray(OutValue, Depth);
+
+            case '"':
+                {
+                    FString String;
+                    if (!ReadString(String))
+                    {
+                        return false;
+                    }
+                    OutValue = MakeShared<FJsonValueString>(MoveTemp(String));
+                    return true;
+                }
+
+            case 't':
+                OutValue = FSharedJsonValues::Get().True;
+                return ReadLiteral("true", 4);
+
+            case 'f':
+                OutValue = FSharedJsonValues::Get().False;
+                return ReadLiteral("false", 5);
+
+            case 'n':
+                OutValue = FSharedJsonValues::Get().Null;
+                return ReadLiteral("null", 4);
+
+            default:
+                {
+                    double Number;
+                    if (!ReadNumber(Number))
+                    {
+                        return false;
+                    }
+                    OutValue = FSharedJsonValues::Get().MakeNumber(Number);
+                    return true;
+                }
+            }
+        }
+
+        bool ReadObject(TSharedPtr<FJsonObject>& OutObject, int32 Depth)
+        {
+            SkipWhitespace();
+            if (!Consume('{'))
+            {
+                return false;
+            }
+
+            OutObject = MakeShared<FJsonObject>();
+
+            SkipWhitespace();
+            if (Consume('}'))
+            {
+                return true;
+            }
+
+            for (;;)
+            {
+                SkipWhitespace();
+                FString Key;
+                if (!ReadString(Key))
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+                if (!Consume(':'))
+                {
+                    return false;
+                }
+
+                TSharedPtr<FJsonValue> Value;
+                if (!ReadValue(Value, Depth + 1))
+                {
+                    return false;
+                }
+                OutObject->Values.Add(MoveTemp(Key), MoveTemp(Value));
+
+                SkipWhitespace();
+                if (Consume('}'))
+                {
+                    return true;
+                }
+                if (!Consume(','))
+                {
+                    return false;
+                }
+            }
+        }
+
+        bool AtEnd()
+        {
+            SkipWhitespace();
+            return Offset == Num;
+        }
+
+    private:
+        void SkipWhitespace()
+        {
+            while (Offset < Num && (Data[Offset] == ' ' || Data[Offset] == '\t' || Data[Offset] == '\n' || Data[Offset] == '\r'))
+            {
+                ++Offset;
+            }
+        }
+
+        bool Consume(uint8 Char)
+        {
+            if (Offset < Num && Data[Offset] == Char)
+            {
+                ++Offset;
+                return true;
+            }
+            return false;
+        }
+
+        bool ReadLiteral(const char* Literal, int32 Length)
+        {
+            if (Num - Offset < Length || FMemory::Memcmp(Data + Offset, Literal, Length) != 0)
+            {
+                return false;
+            }
+            Offset += Length;
+            return true;
+        }
+
+        bool ReadArray(TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            Consume('[');
+
+            // The element count is unknown until the closing bracket, so grow on the FMemStack
+            TArray<TSharedPtr<FJsonValue>, TMemStackAllocator<>> Elements;
+
+            SkipWhitespace();
+            if (!Consume(']'))
+            {
+                for (;;)
+                {
+                    TSharedPtr<FJsonValue> Element;
+                    if (!ReadValue(Element, Depth + 1))
+                    {
+                        return false;
+                    }
+                    Elements.Add(MoveTemp(Element));
+
+                    SkipWhitespace();
+                    if (Consume(']'))
+                    {
+                        break;
+                    }
+                    if (!Consume(','))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            OutValue = MakeShared<FJsonValueArray>(MoveToHeap(Elements));
+            return true;
+        }
+
+        bool ReadNumber(double& OutNumber)
+        {
+            // Validate the JSON number grammar while finding its end
+            const int32 Start = Offset;
+            Consume('-');
+
+            const int32 IntegerStart = Offset;
+            while (Offset < Num && FChar::IsDigit(Data[Offset]))
+            {
+                ++Offset;
+            }
+            if (Offset == IntegerStart)
+            {
+                return false;
+            }
+
+            if (Consume('.'))
+            {
+                const int32 FractionStart = Offset;
+                while (Offset < Num && FChar::IsDigit(Data[Offset]))
+                {
+                    ++Offset;
+                }
+                if (Offset == FractionStart)
+                {
+                    return false;
+                }
+            }
+
+            if (Consume('e') || Consume('E'))
+            {
+                if (!Consume('+'))
+                {
+                    Consume('-');
+                }
+                const int32 ExponentStart = Offset;
+                while (Offset < Num && FChar::IsDigit(Data[Offset]))
+                {
+                    ++Offset;
+                }
+                if (Offset == ExponentStart)
+                {
+                    return false;
+                }
+            }
+
+            // Atod needs a terminated string; numbers are short, so copy them to the stack
+            ANSICHAR Buffer[64];
+            const int32 Length = Offset - Start;
+            if (Length >= UE_ARRAY_COUNT(Buffer))
+            {
+                return false;
+            }
+            FMemory::Memcpy(Buffer, Data + Start, Length);
+            Buffer[Length] = '\0';
+
+            OutNumber = FCStringAnsi::Atod(Buffer);
+            return true;
+        }
+
+        static int32 HexValue(uint8 Char)
+        {
+            if (Char >= '0' && Char <= '9') return Char - '0';
+            if (Char >= 'a' && Char <= 'f') return Char - 'a' + 10;
+            if (Char >= 'A' && Char <= 'F') return Char - 'A' + 10;
+            return -1;
+        }
+
+        bool ReadHex4(uint32& OutCodeUnit)
+        {
+            if (Num - Offset < 4)
+            {
+                return false;
+            }
+
+            OutCodeUnit = 0;
+            for (int32 Index = 0; Index < 4; ++Index)
+            {
+                const int32 Digit = HexValue(Data[Offset++]);
+                if (Digit < 0)
+                {
+                    return false;
+                }
+                OutCodeUnit = (OutCodeUnit << 4) | uint32(Digit);
+            }
+            return true;
+        }
+
+        static void AppendUtf8(TArray<ANSICHAR, TInlineAllocator<256>>& Out, uint32 CodePoint)
+        {
+            if (CodePoint < 0x80)
+            {
+                Out.Add(ANSICHAR(CodePoint));
+            }
+            else if (CodePoint < 0x800)
+            {
+                Out.Add(ANSICHAR(0xC0 | (CodePoint >> 6)));
+                Out.Add(ANSICHAR(0x80 | (CodePoint & 0x3F)));
+            }
+            else if (CodePoint < 0x10000)
+            {
+                Out.Add(ANSICHAR(0xE0 | (CodePoint >> 12)));
+                Out.Add(ANSICHAR(0x80 | ((CodePoint >> 6) & 0x3F)));
+                Out.Add(ANSICHAR(0x80 | (CodePoint & 0x3F)));
+            }
+            else
+            {
+                Out.Add(ANSICHAR(0xF0 | (CodePoint >> 18)));
+                Out.Add(ANSICHAR(0x80 | ((CodePoint >> 12) & 0x3F)));
+                Out.Add(ANSICHAR(0x80 | ((CodePoint >> 6) & 0x3F)));
+                Out.Add(ANSICHAR(0x80 | (CodePoint & 0x3F)));
+            }
+        }
+
+        bool ReadString(FString& OutString)
+        {
+            if (!Consume('"'))
+            {
+                return false;
+            }
+
+            // With a structural index the closing quote is already known, and stage 1 has
+            // rejected raw control characters, so only escapes still need looking for
+            if (Structurals)
+            {
+                while (Cursor < Structurals->Num() && (*Structurals)[Cursor] < Offset)
+                {
+                    ++Cursor;
+                }
+                if (Cursor >= Structurals->Num())
+                {
+                    return false;
+                }
+
+                const int32 End = (*Structurals)[Cursor];
+                if (Data[End] == '"' && !memchr(Data + Offset, '\\', End - Offset))
+                {
+                    FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data + Offset), End - Offset);
+                    OutString = FString(Converter.Length(), Converter.Get());
+                    Offset = End + 1;
+                    return true;
+                }
+            }
+
+            // Fast path: most strings have no escapes and convert straight from the message bytes
+            const int32 Start = Offset;
+            while (Offset < Num && Data[Offset] != '"' && Data[Offset] != '\\')
+            {
+                if (Data[Offset] < 0x20)
+                {
+                    return false;
+                }
+                ++Offset;
+            }
+            if (Offset >= Num)
+            {
+                return false;
+            }
+            if (Data[Offset] == '"')
+            {
+                FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data + Start), Offset - Start);
+                OutString = FString(Converter.Length(), Converter.Get());
+                ++Offset;
+                return true;
+            }
+
+            // Slow path: unescape into a UTF-8 scratch buffer, then convert once
+            TArray<ANSICHAR, TInlineAllocator<256>> Unescaped;
+            Unescaped.Append(reinterpret_cast<const ANSICHAR*>(Data + Start), Offset - Start);
+
+            while (Offset < Num)
+            {
+                const uint8 Char = Data[Offset++];
+                if (Char == '"')
+                {
+                    FUTF8ToTCHAR Converter(Unescaped.GetData(), Unescaped.Num());
+                    OutString = FString(Converter.Length(), Converter.Get());
+                    return true;
+                }
+                if (Char < 0x20)
+                {
+                    return false;
+                }
+                if (Char != '\\')
+                {
+                    Unescaped.Add(ANSICHAR(Char));
+                    continue;
+                }
+
+                if (Offset >= Num)
+                {
+                    return false;
+                }
+                switch (Data[Offset++])
+                {
+                case '"': Unescaped.Add('"'); break;
+                case '\\': Unescaped.Add('\\'); break;
+                case '/': Unescaped.Add('/'); break;
+                case 'b': Unescaped.Add('\b'); break;
+                case 'f': Unescaped.Add('\f'); break;
+                case 'n': Unescaped.Add('\n'); break;
+                case 'r': Unescaped.Add('\r'); break;
+                case 't': Unescaped.Add('\t'); break;
+                case 'u':
+                    {
+                        uint32 CodePoint;
+                        if (!ReadHex4(CodePoint))
+                        {
+                            return false;
+                        }
+
+                        // Characters outside the BMP arrive as a surrogate pair
+                        if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Num - Offset >= 6 && Data[Offset] == '\\' && Data[Offset + 1] == 'u')
+                        {
+                            const int32 PairStart = Offset;
+                            Offset += 2;
+                            uint32 Low;
+                            if (ReadHex4(Low) && Low >= 0xDC00 && Low <= 0xDFFF)
+                            {
+                                CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+                            }
+                            else
+                            {
+                                Offset = PairStart;
+                            }
+                        }
+
+                        AppendUtf8(Unescaped, CodePoint);
+                        break;
+                    }
+                default:
+                    return false;
+                }
+            }
+
+            return false;
+        }
+
+        const uint8* Data;
+        int32 Num;
+        int32 Offset;
+
+        /** Optional stage 1 index of quotes and structural characters */
+        const TArray<int32>* Structurals;
+
+        /** First index entry not yet behind Offset */
+        int32 Cursor;
+    };
+
+    bool IsJsonWhitespace(uint8 Char)
+    {
+        return Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r';
+    }
+
+    /** Index just past the closing quote of the JSON string opening at Start, or INDEX_NONE if it never closes */
+    int32 SkipJsonString(const uint8* Data, int32 Num, int32 Start)
+    {
+        for (int32 Pos = Start + 1; Pos < Num; ++Pos)
+        {
+            if (Data[Pos] == '\\')
+            {
+                ++Pos;
+            }
+            else if (Data[Pos] == '"')
+            {
+                return Pos + 1;
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    /**
+     * Locate a scalar member of the top-level JSON object without decoding anything
+     * Strings and nested containers are stepped over byte by byte, so a large params subtree costs one pass
+     * @param Data - The UTF-8 text
+     * @param Num - Number of bytes
+     * @param Name - The member's key, as UTF-8
+     * @param NameLength - Length of the key in bytes
+     * @param OutStart - Offset of the member's value text
+     * @param OutEnd - Offset just past the member's value text
+     * @return True if the member was found with a string, number or literal value
+     */
+    bool FindJsonScalarMember(const uint8* Data, int32 Num, const ANSICHAR* Name, int32 NameLength, int32& OutStart, int32& OutEnd)
+    {
+        int32 Pos = 0;
+        while (Pos < Num && IsJsonWhitespace(Data[Pos]))
+        {
+            ++Pos;
+        }
+        if (Pos >= Num || Data[Pos] != '{')
+        {
+            return false;
+        }
+        ++Pos;
+
+        int32 Depth = 1;
+        bool bAtKey = true;
+        while (Pos < Num && Depth > 0)
+        {
+            if (Data[Pos] == '"')
+            {
+                const int32 End = SkipJsonString(Data, Num, Pos);
+                if (End == INDEX_NONE)
+                {
+                    return false;
+                }
+
+                const bool bMatch = Depth == 1 && bAtKey && End - Pos - 2 == NameLength
+                    && FMemory::Memcmp(Data + Pos + 1, Name, NameLength) == 0;
+                bAtKey = false;
+                Pos = End;
+                if (!bMatch)
+                {
+                    continue;
+                }
+
+                while (Pos < Num && IsJsonWhitespace(Data[Pos]))
+                {
+                    ++Pos;
+                }
+                if (Pos >= Num || Data[Pos] != ':')
+                {
+                    return false;
+                }
+                ++Pos;
+                while (Pos < Num && IsJsonWhitespace(Data[Pos]))
+                {
+                    ++Pos;
+                }
+                if (Pos >= Num || Data[Pos] == '{' || Data[Pos] == '[')
+                {
+                    return false;
+                }
+
+                OutStart = Pos;
+                if (Data[Pos] == '"')
+                {
+                    OutEnd = SkipJsonString(Data, Num, Pos);
+                    return OutEnd != INDEX_NONE;
+                }
+
+                while (Pos < Num && Data[Pos] != ',' && Data[Pos] != '}' && !IsJsonWhitespace(Data[Pos]))
+                {
+                    ++Pos;
+                }
+                OutEnd = Pos;
+                return OutEnd > OutStart;
+            }
+
+            switch (Data[Pos])
+            {
+            case '{':
+            case '[':
+                ++Depth;
+                break;
+            case '}':
+            case ']':
+                --Depth;
+                break;
+            case ',':
+                bAtKey = Depth == 1;
+                break;
+            default:
+                break;
+            }
+            ++Pos;
+        }
+
+        return false;
+    }
+}
+
+EMCPWireEncoding FMCPWireCodec::Detect(const TArray<uint8>& Payload)
+{
+    return Detect(Payload.GetData(), Payload.Num());
+}
+
+EMCPWireEncoding FMCPWireCodec::Detect(const uint8* Data, int32 Num)
+{
+    // A CBOR request is a map, whose major type can never be the first byte of JSON text
+    if (Num > 0 && static_cast<ECborMajorType>(Data[0] >> 5) == ECborMajorType::Map)
+    {
+        return EMCPWireEncoding::Cbor;
+    }
+    return EMCPWireEncoding::Json;
+}
+
+bool FMCPWireCodec::DecodeCbor(const TArray<uint8>& Payload, TSharedPtr<FJsonObject>& OutObject)
+{
+    return DecodeCbor(Payload.GetData(), Payload.Num(), OutObject);
+}
+
+bool FMCPWireCodec::DecodeCbor(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject)
+{
+    // Scratch used while decoding is released as soon as the object tree is built
+    FMemMark Mark(FMemStack::Get());
+    FCborDecoder Decoder(Data, Num);
+
+    TSharedPtr<FJsonValue> Value;
+    if (!Decoder.ReadValue(Value, 0) || !Decoder.AtEnd() || Value->Type != EJson::Object)
+    {
+        return false;
+    }
+
+    OutObject = Value->AsObject();
+    return OutObject.IsValid();
+}
+
+bool FMCPWireCodec::Decode(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject)
+{
+    if (Detect(Data, Num) == EMCPWireEncoding::Cbor)
+    {
+        return DecodeCbor(Data, Num, OutObject);
+    }
+
+    return DecodeJson(Data, Num, OutObject);
+}
+
+TSharedPtr<FJsonValue> FMCPWireCodec::FindScalarMember(const uint8* Data, int32 Num, const TCHAR* Name)
+{
+    TSharedPtr<FJsonValue> Value;
+    if (Detect(Data, Num) == EMCPWireEncoding::Cbor)
+    {
+        FCborDecoder Decoder(Data, Num);
+        return Decoder.FindScalarMember(Name, Value) ? Value : nullptr;
+    }
+
+    const FTCHARToUTF8 Utf8Name(Name);
+    int32 Start;
+    int32 End;
+    if (!FindJsonScalarMember(Data, Num, Utf8Name.Get(), Utf8Name.Length(), Start, End))
+    {
+        return nullptr;
+    }
+
+    FJsonUtf8Decoder Decoder(Data + Start, End - Start);
+    return Decoder.ReadValue(Value, 0) && Decoder.AtEnd() ? Value : nullptr;
+}
+
+bool FMCPWireCodec::DecodeJson(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject, int32 IndexThreshold)
+{
+    // Scratch used while decoding is released as soon as the object tree is built
+    FMemMark Mark(FMemStack::Get());
+
+    if (Num < IndexThreshold)
+    {
+        FJsonUtf8Decoder Decoder(Data, Num);
+        return Decoder.ReadObject(OutObject, 0) && Decoder.AtEnd();
+    }
+
+    FMCPJsonStructuralIndex Index;
+    if (!Index.Build(Data, Num))
+    {
+        return false;
+    }
+
+    FJsonUtf8Decoder Decoder(Data, Num, &Index.GetPositions());
+    return Decoder.ReadObject(OutObject, 0) && Decoder.AtEnd();
+}
+
+void FMCPWireCodec::EncodeJson(const TSharedRef<FJsonObject>& Object, TArray<uint8>& OutPayload)
+{
+    FJsonUtf8Encoder Encoder(OutPayload);
+    Encoder.WriteObject(Object);
+}
+
+void FMCPWireCodec::EncodeCbor(const TSharedRef<FJsonObject>& Object, TArray<uint8>& OutPayload)
+{
+    FCborEncoder Encoder(OutPayload);
+    Encoder.WriteObject(Object);
+}
+
+bool FMCPWireCodec::FromName(const FString& Name, EMCPWireEncoding& OutEncoding)
+{
+    if (Name.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+    {
+        OutEncoding = EMCPWireEncoding::Json;
+        return true;
+    }
+    if (Name.Equals(TEXT("cbor"), ESearchCase::IgnoreCase))
+    {
+        OutEncoding = EMCPWireEncoding::Cbor;
+        return true;
+    }
+    return false;
+}
+
+const TCHAR* FMCPWireCodec::ToName(EMCPWireEncoding Encoding)
+{
+    switch (Encoding)
+    {
+    case EMCPWireEncoding::Cbor:
+        return TEXT("cbor");
+    default:
+        return TEXT("json");
+    }
+}
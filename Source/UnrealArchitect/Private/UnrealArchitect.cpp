@@ -481,9 +481,20 @@ void FUnrealArchitectModule::StartServer()
 	MCP_LOG_WARNING("Creating new server instance");
 	const UMCPSettings* Settings = GetDefault<UMCPSettings>();
 	
-	// Create a config object and set the port from settings
+	// Create a config object from settings
 	FMCPTCPServerConfig Config;
 	Config.Port = Settings->Port;
+	Config.ClientTimeoutSeconds = Settings->IdleTimeoutSeconds;
+	Config.RequestTimeoutSeconds = Settings->RequestTimeoutSeconds;
+	Config.WriteTimeoutSeconds = Settings->WriteTimeoutSeconds;
+	Config.MaxConnections = Settings->MaxConnections;
+	Config.MaxInFlightRequests = Settings->MaxInFlightRequests;
+	Config.RateLimitPerSecond = Settings->RateLimitPerSecond;
+	Config.RateLimitBurst = Settings->RateLimitBurst;
+	Config.FrameBudgetMilliseconds = Settings->FrameBudgetMilliseconds;
+	Config.bRunThreadSafeCommandsOnWorkers = Settings->bRunThreadSafeCommandsOnWorkers;
+	Config.CompressionThreshold = Settings->CompressionThreshold;
+	Config.UnixSocketPath = Settings->UnixSocketPath;
 	
 	// Create the server with the config
 	Server = MakeUnique<FMCPTCPServer>(Config);
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * Token bucket rate limiter
+ * Holds up to Burst tokens and refills at Rate tokens per second; a request spends tokens equal
+ * to its cost. Not thread-safe on its own.
+ */
+struct FMCPTokenBucket
+{
+    /** Tokens added per second, 0 for no limit */
+    double Rate = 0.0;
+
+    /** Most tokens the bucket holds */
+    double Burst = 0.0;
+
+    /** Tokens currently available */
+    double Tokens = 0.0;
+
+    /** When Tokens was last topped up, in FPlatformTime::Seconds */
+    double LastRefillTime = 0.0;
+
+    /**
+     * Spend tokens if enough are available
+     * A cost larger than the bucket is capped at Burst, so every request can eventually run
+     * @param Cost - Tokens to spend
+     * @param Now - The current time, in FPlatformTime::Seconds
+     * @param OutRetryAfterSeconds - When refused, how long until enough tokens will be available
+     * @return True if the tokens were spent
+     */
+    bool TryConsume(double Cost, double Now, double& OutRetryAfterSeconds);
+};
+
+/**
+ * Admission state for one client connection
+ * Shared by the connection, owned by the I/O thread, and by every request it has in flight,
+ * which may be executing on another thread
+ */
+class UNREALARCHITECT_API FMCPClientAdmission
+{
+public:
+    /**
+     * Constructor
+     * @param RatePerSecond - Command cost the client may spend per second, 0 for no limit
+     * @param Burst - Command cost the client may spend at once after being quiet
+     */
+    FMCPClientAdmission(double RatePerSecond, double Burst);
+
+    /**
+     * Count a request as in flight unless the client already has too many (I/O thread)
+     * @param MaxInFlight - Most requests the client may have queued or executing, 0 for no limit
+     * @return False if the request must be refused
+     */
+    bool TryBeginRequest(int32 MaxInFlight);
+
+    /**
+     * Count a request as finished (any thread)
+     */
+    void EndRequest();
+
+    /** @return Number of requests queued or executing */
+    int32 GetInFlight() const { return InFlight.load(std::memory_order_relaxed); }
+
+    /**
+     * Charge a command's cost against the client's rate limit (any thread)
+     * @param Cost - The command's cost
+     * @param OutRetryAfterSeconds - When refused, how long until the command would be admitted
+     * @return False if the command must be refused
+     */
+    bool TryCharge(double Cost, double& OutRetryAfterSeconds);
+
+    /**
+     * Account for responses queued for the client but not yet handed to the I/O thread (any thread)
+     * @param Delta - Bytes added, or removed when negative
+     */
+    void AddPendingResponseBytes(int64 Delta) { PendingResponseBytes.fetch_add(Delta, std::memory_order_relaxed); }
+
+    /**
+     * Publish how many framed response bytes the connection has yet to write (I/O thread)
+     * @param Bytes - The connection's queued outbound bytes
+     */
+    void SetOutboundBytes(int64 Bytes) { OutboundBytes.store(Bytes, std::memory_order_relaxed); }
+
+    /** @return Response bytes produced for the client that it has not read yet */
+    int64 GetUnsentBytes() const { return PendingResponseBytes.load(std::memory_order_relaxed) + OutboundBytes.load(std::memory_order_relaxed); }
+
+    /** Record that the connection has been closed (I/O thread) */
+    void MarkClosed() { bClosed.store(true, std::memory_order_relaxed); }
+
+    /** @return True once the connection has been closed, so work for it can be abandoned */
+    bool IsClosed() const { return bClosed.load(std::memory_order_relaxed); }
+
+private:
+    /** Requests queued or executing */
+    std::atomic<int32> InFlight;
+
+    /** Encoded responses in the server's response queue */
+    std::atomic<int64> PendingResponseBytes{0};
+
+    /** Framed responses in the connection's outbound queue */
+    std::atomic<int64> OutboundBytes{0};
+
+    /** Whether the connection has been closed */
+    std::atomic<bool> bClosed{false};
+
+    /** The client's rate limit */
+    FMCPTokenBucket Bucket;
+
+    /** Guards Bucket */
+    FCriticalSection BucketLock;
+};
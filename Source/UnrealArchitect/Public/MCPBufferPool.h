@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPConstants.h"
+#include <atomic>
+
+/**
+ * Pool of byte buffers in power-of-two size classes
+ * Connections borrow a buffer while they have partially received data and hand it back once
+ * they go quiet, so idle connections hold no buffer memory. Buffers above the largest pooled
+ * class are allocated and freed as needed.
+ * Not thread-safe: only the I/O thread lends and returns buffers. The byte counts can be read
+ * from any thread.
+ */
+class UNREALARCHITECT_API FMCPBufferPool
+{
+public:
+    /**
+     * Constructor
+     * @param InMaxPooledBytes - Most memory kept in free buffers; returns beyond this are freed
+     */
+    explicit FMCPBufferPool(int64 InMaxPooledBytes = MCPConstants::BUFFER_POOL_MAX_BYTES);
+
+    /**
+     * Borrow an empty buffer
+     * @param MinCapacity - Bytes the buffer must hold without reallocating
+     * @return A buffer with Num() == 0 and Max() >= MinCapacity
+     */
+    TArray<uint8> Acquire(int32 MinCapacity);
+
+    /**
+     * Return a buffer; its contents are discarded
+     * @param Buffer - The buffer, left empty with no allocation
+     */
+    void Release(TArray<uint8>&& Buffer);
+
+    /** @return Bytes held in free buffers */
+    int64 GetPooledBytes() const { return PooledBytes.load(std::memory_order_relaxed); }
+
+    /** @return Bytes in buffers currently lent out */
+    int64 GetLentBytes() const { return LentBytes.load(std::memory_order_relaxed); }
+
+private:
+    /** Size class of the smallest and largest pooled buffers, as powers of two */
+    static constexpr int32 MIN_CLASS = 12;
+    static constexpr int32 MAX_CLASS = 20;
+
+    /** Free buffers by size class; every buffer in class N holds at least 2^N bytes */
+    TArray<TArray<uint8>> FreeBuffers[MAX_CLASS - MIN_CLASS + 1];
+
+    /** Most memory kept in free buffers */
+    int64 MaxPooledBytes;
+
+    /** Bytes held in free buffers */
+    std::atomic<int64> PooledBytes;
+
+    /** Bytes in buffers currently lent out */
+    std::atomic<int64> LentBytes;
+};
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "MCPTCPServer.h"
+#include "MCPJsonKeys.h"
+#include "MCPParamBinding.h"
 #include "Engine/World.h"
 #include "Engine/StaticMeshActor.h"
 #include "Components/StaticMeshComponent.h"
@@ -15,9 +17,11 @@ public:
     /**
      * Constructor
      * @param InCommandName - The command name this handler responds to
+     * @param InTraits - What the command declares about itself
      */
-    explicit FMCPCommandHandlerBase(const FString& InCommandName)
+    explicit FMCPCommandHandlerBase(const FString& InCommandName, const FMCPCommandTraits& InTraits = FMCPCommandTraits())
         : CommandName(InCommandName)
+        , Traits(InTraits)
     {
     }
 
@@ -30,6 +34,15 @@ public:
         return CommandName;
     }
 
+    /**
+     * Get what the command declares about itself
+     * @return The command's traits
+     */
+    virtual FMCPCommandTraits GetTraits() const override
+    {
+        return Traits;
+    }
+
 protected:
     /**
      * Create an error response
@@ -38,10 +51,7 @@ protected:
      */
     TSharedPtr<FJsonObject> CreateErrorResponse(const FString& Message)
     {
-        TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-        Response->SetStringField("status", "error");
-        Response->SetStringField("message", Message);
-        return Response;
+        return MCPJsonKeys::MakeErrorResponse(Message);
     }
 
     /**
@@ -52,16 +62,57 @@ protected:
     TSharedPtr<FJsonObject> CreateSuccessResponse(TSharedPtr<FJsonObject> Result = nullptr)
     {
         TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-        Response->SetStringField("status", "success");
+        MCPJsonKeys::Status.Set(*Response, MCPJsonKeys::StatusSuccess);
         if (Result.IsValid())
         {
-            Response->SetObjectField("result", Result);
+            MCPJsonKeys::Result.Set(*Response, MakeShared<FJsonValueObject>(Result));
         }
         return Response;
     }
 
     /** The command name this handler responds to */
     FString CommandName;
+    
+    /** What the command declares about itself */
+    FMCPCommandTraits Traits;
+};
+
+/**
+ * Base class for handlers whose parameters bind to a struct
+ * TParams must provide a static GetSchema() returning its TMCPParamSchema. Parameters are bound
+ * before ExecuteTyped is called; binding failures are answered with the schema's error message.
+ */
+template <typename TParams>
+class TMCPTypedCommandHandler : public FMCPCommandHandlerBase
+{
+public:
+    using FMCPCommandHandlerBase::FMCPCommandHandlerBase;
+
+    /**
+     * Bind the parameters and execute the command
+     * @param Params - The command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override final
+    {
+        TParams Bound;
+        FString Error;
+        if (!TParams::GetSchema().Bind(*Params, Bound, Error))
+        {
+            return CreateErrorResponse(Error);
+        }
+        return ExecuteTyped(Bound, ClientSocket);
+    }
+
+protected:
+    /**
+     * Execute the command with bound parameters
+     * @param Params - The validated command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> ExecuteTyped(const TParams& Params, FSocket* ClientSocket) = 0;
 };
 
 /**
@@ -71,7 +122,8 @@ class FMCPGetSceneInfoHandler : public FMCPCommandHandlerBase
 {
 public:
     FMCPGetSceneInfoHandler()
-        : FMCPCommandHandlerBase("get_scene_info")
+        : FMCPCommandHandlerBase("get_scene_info", FMCPCommandTraits().ReadOnly().Idempotent()
+            .CacheFor(MCPConstants::QUERY_CACHE_SECONDS).WithCost(MCPConstants::HEAVY_COMMAND_COST).WithPriority(EMCPCommandPriority::Low))
     {
     }
 
@@ -82,28 +134,65 @@ public:
      * @return JSON response object
      */
     virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+
+    virtual bool SupportsStreaming() const override { return true; }
+
+    /**
+     * Execute the get_scene_info command as a stream of actor batches, without the actor limit
+     * @param Params - The command parameters; "chunk_size" sets the actors per chunk
+     * @param Stream - Receives the level header, actor chunks and trailer
+     * @return Producer that sends one chunk per step
+     */
+    virtual TSharedPtr<IMCPStreamProducer> BeginStreaming(const TSharedPtr<FJsonObject>& Params, FMCPResponseStream& Stream) override;
+
+    /**
+     * Describe an actor for the scene listing
+     * @param Actor - The actor to describe
+     * @return JSON value with the actor's name, type, label and location
+     */
+    static TSharedPtr<FJsonValue> MakeActorInfo(AActor* Actor);
+};
+
+/**
+ * Parameters of the create_object command
+ */
+struct FMCPCreateObjectParams
+{
+    /** Actor type: "StaticMeshActor" or "cube" */
+    FString Type;
+
+    /** Where to spawn the actor */
+    FVector Location = FVector::ZeroVector;
+
+    /** Optional static mesh asset path, for StaticMeshActor */
+    FString Mesh;
+
+    /** Optional outliner label */
+    FString Label;
+
+    static const TMCPParamSchema<FMCPCreateObjectParams>& GetSchema();
 };
 
 /**
  * Handler for the create_object command
  */
-class FMCPCreateObjectHandler : public FMCPCommandHandlerBase
+class FMCPCreateObjectHandler : public TMCPTypedCommandHandler<FMCPCreateObjectParams>
 {
 public:
     FMCPCreateObjectHandler()
-        : FMCPCommandHandlerBase("create_object")
+        : TMCPTypedCommandHandler<FMCPCreateObjectParams>("create_object")
     {
     }
 
+protected:
     /**
      * Execute the create_object command
      * @param Params - The command parameters
      * @param ClientSocket - The client socket
      * @return JSON response object
      */
-    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+    virtual TSharedPtr<FJsonObject> ExecuteTyped(const FMCPCreateObjectParams& Params, FSocket* ClientSocket) override;
 
-protected:
     /**
      * Create a static mesh actor
      * @param World - The world to create the actor in
@@ -124,24 +213,45 @@ protected:
     TPair<AStaticMeshActor*, bool> CreateCubeActor(UWorld* World, const FVector& Location, const FString& Label = "");
 };
 
+/**
+ * Parameters of the modify_object command
+ */
+struct FMCPModifyObjectParams
+{
+    /** Name of the actor to modify */
+    FString Name;
+
+    /** New location, if changing */
+    TOptional<FVector> Location;
+
+    /** New rotation, if changing */
+    TOptional<FRotator> Rotation;
+
+    /** New scale, if changing */
+    TOptional<FVector> Scale;
+
+    static const TMCPParamSchema<FMCPModifyObjectParams>& GetSchema();
+};
+
 /**
  * Handler for the modify_object command
  */
-class FMCPModifyObjectHandler : public FMCPCommandHandlerBase
+class FMCPModifyObjectHandler : public TMCPTypedCommandHandler<FMCPModifyObjectParams>
 {
 public:
     FMCPModifyObjectHandler()
-        : FMCPCommandHandlerBase("modify_object")
+        : TMCPTypedCommandHandler<FMCPModifyObjectParams>("modify_object", FMCPCommandTraits().Idempotent())
     {
     }
 
+protected:
     /**
      * Execute the modify_object command
      * @param Params - The command parameters
      * @param ClientSocket - The client socket
      * @return JSON response object
      */
-    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+    virtual TSharedPtr<FJsonObject> ExecuteTyped(const FMCPModifyObjectParams& Params, FSocket* ClientSocket) override;
 };
 
 /**
@@ -151,7 +261,7 @@ class FMCPDeleteObjectHandler : public FMCPCommandHandlerBase
 {
 public:
     FMCPDeleteObjectHandler()
-        : FMCPCommandHandlerBase("delete_object")
+        : FMCPCommandHandlerBase("delete_object", FMCPCommandTraits().Idempotent())
     {
     }
 
@@ -171,7 +281,7 @@ class FMCPExecutePythonHandler : public FMCPCommandHandlerBase
 {
 public:
     FMCPExecutePythonHandler()
-        : FMCPCommandHandlerBase("execute_python")
+        : FMCPCommandHandlerBase("execute_python", FMCPCommandTraits().WithCost(MCPConstants::HEAVY_COMMAND_COST).WithPriority(EMCPCommandPriority::Low))
     {
     }
 
@@ -182,4 +292,91 @@ public:
      * @return JSON response object
      */
     virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+};
+
+/**
+ * Handler for the get_server_status command
+ * Reports command queue depth and scheduler statistics
+ */
+class FMCPGetServerStatusHandler : public FMCPCommandHandlerBase
+{
+public:
+    explicit FMCPGetServerStatusHandler(FMCPTCPServer& InServer)
+        : FMCPCommandHandlerBase("get_server_status", FMCPCommandTraits().ReadOnly().Idempotent().WithPriority(EMCPCommandPriority::High))
+        , Server(InServer)
+    {
+    }
+
+    /**
+     * Execute the get_server_status command
+     * @param Params - The command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+
+private:
+    /** The server being reported on */
+    FMCPTCPServer& Server;
+};
+
+/**
+ * Handler for the negotiate_encoding command
+ * Lets a client pick a wire encoding both sides support before switching to it, and opt
+ * in to compressed responses. The server detects the encoding of every request, so only
+ * the compression choice is remembered per connection
+ */
+class FMCPNegotiateEncodingHandler : public FMCPCommandHandlerBase
+{
+public:
+    explicit FMCPNegotiateEncodingHandler(FMCPTCPServer& InServer)
+        : FMCPCommandHandlerBase("negotiate_encoding", FMCPCommandTraits().ReadOnly().Idempotent().WithPriority(EMCPCommandPriority::High))
+        , Server(InServer)
+    {
+    }
+
+    /**
+     * Execute the negotiate_encoding command
+     * @param Params - The command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+
+private:
+    /** The server whose connection is being configured */
+    FMCPTCPServer& Server;
+};
+
+/**
+ * Handler for the benchmark_json_decode command
+ * Times the request decoders against each other on a generated payload shaped like a bulk
+ * batch or a large transform list: the engine's JSON reader over an FString, the direct
+ * UTF-8 reader, and the UTF-8 reader fed by the SIMD structural index
+ */
+class FMCPBenchmarkJsonDecodeHandler : public FMCPCommandHandlerBase
+{
+public:
+    FMCPBenchmarkJsonDecodeHandler()
+        : FMCPCommandHandlerBase("benchmark_json_decode", FMCPCommandTraits().ReadOnly().Idempotent().ThreadSafe()
+            .WithCost(MCPConstants::HEAVY_COMMAND_COST).WithPriority(EMCPCommandPriority::Low))
+    {
+    }
+
+    /**
+     * Execute the benchmark_json_decode command
+     * @param Params - The command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+
+private:
+    /**
+     * Generate a representative request payload
+     * @param Shape - "batch" for a batch of modify_object commands, "transform" for one command with a flat transform list
+     * @param Count - Number of commands or transforms
+     * @param OutPayload - Receives the UTF-8 request text
+     */
+    static void MakePayload(const FString& Shape, int32 Count, TArray<uint8>& OutPayload);
 }; 
\ No newline at end of file
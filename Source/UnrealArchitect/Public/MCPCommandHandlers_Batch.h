@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPCommandHandlers.h"
+
+/**
+ * Handler for the batch command
+ * Executes a list of sub-commands through the server's registered handlers in one dispatch
+ * and returns one result per sub-command
+ */
+class FMCPBatchHandler : public FMCPCommandHandlerBase
+{
+public:
+    /**
+     * Constructor
+     * @param InServer - The server whose command handlers execute the sub-commands
+     */
+    explicit FMCPBatchHandler(FMCPTCPServer& InServer)
+        : FMCPCommandHandlerBase(TEXT("batch"), FMCPCommandTraits().WithPriority(EMCPCommandPriority::Low))
+        , Server(InServer)
+    {
+    }
+
+    /**
+     * Execute the batch command
+     * @param Params - The command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+
+    /**
+     * A batch costs what its sub-commands would cost sent one by one
+     * @param Params - The command parameters
+     * @return The summed cost of the entries
+     */
+    virtual double GetCost(const TSharedPtr<FJsonObject>& Params) const override;
+
+private:
+    /**
+     * Execute one entry of the batch
+     * @param Entry - The {type, params} entry
+     * @param ClientSocket - The client socket
+     * @return The sub-command's response
+     */
+    TSharedPtr<FJsonObject> ExecuteEntry(const TSharedPtr<FJsonObject>& Entry, FSocket* ClientSocket);
+
+    /** The server whose handlers are used */
+    FMCPTCPServer& Server;
+};
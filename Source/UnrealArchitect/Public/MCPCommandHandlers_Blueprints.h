@@ -85,7 +85,7 @@ private:
 class FMCPGetBlueprintInfoHandler : public FMCPCommandHandlerBase
 {
 public:
-    FMCPGetBlueprintInfoHandler() : FMCPCommandHandlerBase(TEXT("get_blueprint_info")) {}
+    FMCPGetBlueprintInfoHandler() : FMCPCommandHandlerBase(TEXT("get_blueprint_info"), FMCPCommandTraits().ReadOnly().Idempotent().CacheFor(MCPConstants::QUERY_CACHE_SECONDS)) {}
     virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
 
 private:
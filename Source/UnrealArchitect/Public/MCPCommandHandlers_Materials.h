@@ -30,7 +30,7 @@ private:
 class FMCPGetMaterialInfoHandler : public FMCPCommandHandlerBase
 {
 public:
-    FMCPGetMaterialInfoHandler() : FMCPCommandHandlerBase(TEXT("get_material_info")) {}
+    FMCPGetMaterialInfoHandler() : FMCPCommandHandlerBase(TEXT("get_material_info"), FMCPCommandTraits().ReadOnly().Idempotent().CacheFor(MCPConstants::QUERY_CACHE_SECONDS)) {}
     virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
 
 private:
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPCommandHandlers.h"
+#include "MCPSharedMemoryChannel.h"
+
+/**
+ * Handler for the open_shared_channel command
+ * Creates a shared memory ring buffer that a client on the same machine can write bulk payloads into
+ */
+class FMCPOpenSharedChannelHandler : public FMCPCommandHandlerBase
+{
+public:
+    /**
+     * Constructor
+     * @param InChannels - Registry that owns the channels
+     */
+    explicit FMCPOpenSharedChannelHandler(const TSharedRef<FMCPSharedChannelRegistry>& InChannels)
+        : FMCPCommandHandlerBase(TEXT("open_shared_channel"), FMCPCommandTraits().ReadOnly().WithPriority(EMCPCommandPriority::High))
+        , Channels(InChannels)
+    {
+    }
+
+    /**
+     * Execute the open_shared_channel command
+     * @param Params - The command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+
+private:
+    /** Registry that owns the channels */
+    TSharedRef<FMCPSharedChannelRegistry> Channels;
+};
+
+/**
+ * Handler for the close_shared_channel command
+ */
+class FMCPCloseSharedChannelHandler : public FMCPCommandHandlerBase
+{
+public:
+    /**
+     * Constructor
+     * @param InChannels - Registry that owns the channels
+     */
+    explicit FMCPCloseSharedChannelHandler(const TSharedRef<FMCPSharedChannelRegistry>& InChannels)
+        : FMCPCommandHandlerBase(TEXT("close_shared_channel"), FMCPCommandTraits().ReadOnly().Idempotent().WithPriority(EMCPCommandPriority::High))
+        , Channels(InChannels)
+    {
+    }
+
+    /**
+     * Execute the close_shared_channel command
+     * @param Params - The command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+
+private:
+    /** Registry that owns the channels */
+    TSharedRef<FMCPSharedChannelRegistry> Channels;
+};
+
+/**
+ * Handler for the shared_dispatch command
+ * Decodes a {type, params} request directly from a shared memory channel and executes it,
+ * returning that command's response
+ */
+class FMCPSharedDispatchHandler : public FMCPCommandHandlerBase
+{
+public:
+    /**
+     * Constructor
+     * @param InServer - The server whose command handlers execute the request
+     * @param InChannels - Registry that owns the channels
+     */
+    FMCPSharedDispatchHandler(FMCPTCPServer& InServer, const TSharedRef<FMCPSharedChannelRegistry>& InChannels)
+        : FMCPCommandHandlerBase(TEXT("shared_dispatch"), FMCPCommandTraits().WithPriority(EMCPCommandPriority::Low))
+        , Server(InServer)
+        , Channels(InChannels)
+    {
+    }
+
+    /**
+     * Execute the shared_dispatch command
+     * @param Params - The command parameters
+     * @param ClientSocket - The client socket
+     * @return JSON response object
+     */
+    virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) override;
+
+    /**
+     * Get the cost of the command carried in the shared payload
+     * The decoded payload is kept for the Execute that follows, so the command that runs is the one that was charged
+     * @param Params - The command parameters
+     * @return The carried command's cost
+     */
+    virtual double GetCost(const TSharedPtr<FJsonObject>& Params) const override;
+
+private:
+    /** A payload's place in a channel, which identifies a request decoded by GetCost */
+    struct FPayloadRange
+    {
+        int32 Channel = 0;
+        int64 Offset = 0;
+        int32 Length = 0;
+
+        bool operator==(const FPayloadRange& Other) const
+        {
+            return Channel == Other.Channel && Offset == Other.Offset && Length == Other.Length;
+        }
+
+        friend uint32 GetTypeHash(const FPayloadRange& Range)
+        {
+            return HashCombine(HashCombine(::GetTypeHash(Range.Channel), ::GetTypeHash(Range.Offset)), ::GetTypeHash(Range.Length));
+        }
+    };
+
+    /**
+     * Read which channel and range a shared_dispatch refers to
+     * @param Params - The shared_dispatch parameters
+     * @param OutRange - Receives the payload's range
+     * @param OutChannel - Receives the channel the payload lies in
+     * @param OutError - Receives the reason on failure
+     * @return False if a field is missing or the channel is unknown
+     */
+    bool FindPayload(const TSharedPtr<FJsonObject>& Params, FPayloadRange& OutRange, FMCPSharedMemoryChannel*& OutChannel, FString& OutError) const;
+
+    /**
+     * Decode a request straight out of shared memory
+     * @param Channel - The channel the payload lies in
+     * @param Range - The payload's range
+     * @param OutRequest - Receives the decoded request
+     * @param bOutReadable - Receives whether the range lies in the channel's unread data
+     * @param OutError - Receives the reason on failure
+     * @return False if the range is not readable or does not hold a well-formed request
+     */
+    bool DecodePayload(FMCPSharedMemoryChannel& Channel, const FPayloadRange& Range, TSharedPtr<FJsonObject>& OutRequest,
+        bool& bOutReadable, FString& OutError) const;
+
+    /** The server whose handlers are used */
+    FMCPTCPServer& Server;
+
+    /** Registry that owns the channels */
+    TSharedRef<FMCPSharedChannelRegistry> Channels;
+
+    /**
+     * Requests decoded by GetCost, taken by the Execute that follows
+     * Keyed by range, since one batch can carry several dispatches
+     */
+    mutable TMap<FPayloadRange, TSharedPtr<FJsonObject>> PeekedRequests;
+};
\ No newline at end of file
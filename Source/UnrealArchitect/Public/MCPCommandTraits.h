@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Order in which queued commands are executed; higher priorities run first within a tick
+ */
+enum class EMCPCommandPriority : uint8
+{
+    /** Connection and server control, e.g. status queries and encoding negotiation */
+    High,
+
+    /** Ordinary scene edits and queries */
+    Normal,
+
+    /** Bulk or expensive work that can wait behind interactive commands */
+    Low,
+
+    Num
+};
+
+/**
+ * What a command handler declares about itself, so the server can choose how to run it
+ * Built fluently, e.g. FMCPCommandTraits().ReadOnly().Idempotent().CacheFor(1.0)
+ */
+struct FMCPCommandTraits
+{
+    /** Does not change editor, level or asset state; running it leaves cached query results valid */
+    bool bReadOnly = false;
+
+    /** Running it twice with the same parameters has the same effect as running it once */
+    bool bIdempotent = false;
+
+    /** Touches no UObjects or other game thread state, so it may execute on any thread */
+    bool bThreadSafe = false;
+
+    /** How long a successful response may be reused for identical parameters, in seconds (0 = never cached) */
+    double CacheSeconds = 0.0;
+
+    /** Estimated cost against the client's rate limit; a typical command costs 1 */
+    double Cost = 1.0;
+
+    /** Scheduling priority */
+    EMCPCommandPriority Priority = EMCPCommandPriority::Normal;
+
+    FMCPCommandTraits& ReadOnly() { bReadOnly = true; return *this; }
+    FMCPCommandTraits& Idempotent() { bIdempotent = true; return *this; }
+    FMCPCommandTraits& ThreadSafe() { bThreadSafe = true; return *this; }
+
+    /** Cache successful responses; only read-only commands can be cached */
+    FMCPCommandTraits& CacheFor(double Seconds) { CacheSeconds = Seconds; return *this; }
+
+    FMCPCommandTraits& WithCost(double InCost) { Cost = InCost; return *this; }
+    FMCPCommandTraits& WithPriority(EMCPCommandPriority InPriority) { Priority = InPriority; return *this; }
+
+    /** @return True if responses may be served from the cache */
+    bool IsCacheable() const { return bReadOnly && CacheSeconds > 0.0; }
+};
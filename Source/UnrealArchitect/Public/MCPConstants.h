@@ -9,10 +9,39 @@ namespace MCPConstants
 {
     // Network constants
     constexpr int32 DEFAULT_PORT = 13377;
-    constexpr int32 DEFAULT_RECEIVE_BUFFER_SIZE = 65536; // 64KB buffer size
+    constexpr int32 DEFAULT_RECEIVE_BUFFER_SIZE = 65536; // 64KB per socket read, shared by all connections
+    constexpr int64 BUFFER_POOL_MAX_BYTES = 8 * 1024 * 1024; // Most memory kept in free reassembly buffers
     constexpr int32 DEFAULT_SEND_BUFFER_SIZE = DEFAULT_RECEIVE_BUFFER_SIZE;
-    constexpr float DEFAULT_CLIENT_TIMEOUT_SECONDS = 30.0f;
-    constexpr float DEFAULT_TICK_INTERVAL_SECONDS = 0.1f;
+    constexpr float DEFAULT_CLIENT_TIMEOUT_SECONDS = 30.0f; // Idle time before a client is disconnected
+    constexpr float DEFAULT_REQUEST_TIMEOUT_SECONDS = 30.0f; // Time allowed to finish sending a request once it has started (0 = unlimited)
+    constexpr float DEFAULT_WRITE_TIMEOUT_SECONDS = 30.0f; // Time a queued response may wait for the client to read it (0 = unlimited)
+    constexpr double TIMER_WHEEL_TICK_SECONDS = 0.1; // Resolution of connection deadlines
+    constexpr int32 DEFAULT_MAX_CONNECTIONS = 64; // Connections beyond this are refused (0 = unlimited)
+    constexpr int32 DEFAULT_MAX_IN_FLIGHT_REQUESTS = 64; // Requests a client may have queued or executing (0 = unlimited)
+    constexpr float DEFAULT_RATE_LIMIT_PER_SECOND = 200.0f; // Command cost a client may spend per second (0 = unlimited)
+    constexpr float DEFAULT_RATE_LIMIT_BURST = 400.0f; // Command cost a client may spend at once after being quiet
+    constexpr double QUERY_CACHE_SECONDS = 1.0; // How long cacheable query responses are reused; bounds staleness from edits made outside MCP
+    constexpr int32 RESPONSE_CACHE_MAX_ENTRIES = 256;
+    constexpr double HEAVY_COMMAND_COST = 5.0; // Rate limit cost of commands that walk the whole scene or run arbitrary scripts
+    constexpr int32 BENCHMARK_MAX_COUNT = 100000; // Most entries in a benchmark_json_decode payload
+    constexpr int64 BENCHMARK_MAX_DECODE_BYTES = 64 * 1024 * 1024; // Most bytes each benchmark_json_decode decoder is run over; iterations are reduced to fit
+    constexpr double BUSY_RETRY_AFTER_SECONDS = 0.1; // Suggested retry delay when a client has too many requests in flight
+    constexpr float DEFAULT_TICK_INTERVAL_SECONDS = 0.0f; // 0 = drain pending commands every editor frame
+    constexpr float DEFAULT_IO_WAIT_SECONDS = 0.005f; // Max time the I/O thread sleeps between socket polls
+    constexpr float DEFAULT_IO_EVENT_WAIT_SECONDS = 0.05f; // Max time the I/O thread blocks waiting for socket events
+    constexpr bool DEFAULT_USE_EVENT_POLLER = true; // Use epoll where available
+    constexpr float DEFAULT_FRAME_BUDGET_MILLISECONDS = 8.0f; // Game thread time spent executing commands per frame (0 = unlimited)
+    constexpr int32 DEFAULT_LISTEN_BACKLOG = 16;
+    constexpr int32 DEFAULT_MAX_MESSAGE_SIZE = 64 * 1024 * 1024; // 64MB, must stay below 0x09000000 for framing auto-detection
+    constexpr int32 FRAME_HEADER_SIZE = 4; // Big-endian uint32 length prefix
+    constexpr uint32 FRAME_COMPRESSED_FLAG = 0x80000000u; // Set in a response's length prefix when its payload is zlib-compressed
+    constexpr int32 DEFAULT_COMPRESSION_THRESHOLD = 16 * 1024; // Smallest response compressed for clients that negotiated it (0 = never)
+    
+    // Shared memory channel constants
+    constexpr uint32 SHARED_RING_MAGIC = 0x5250434D; // "MCPR" as little-endian bytes
+    constexpr int32 DEFAULT_SHARED_CHANNEL_CAPACITY = 16 * 1024 * 1024; // 16MB data area
+    constexpr int32 MAX_SHARED_CHANNEL_CAPACITY = 256 * 1024 * 1024;
+    constexpr int32 MAX_SHARED_CHANNELS = 8;
     
     // Python constants
     constexpr const TCHAR* PYTHON_TEMP_DIR_NAME = TEXT("PythonTemp");
@@ -23,6 +52,9 @@ namespace MCPConstants
     
     // Performance constants
     constexpr int32 MAX_ACTORS_IN_SCENE_INFO = 1000;
+    constexpr int32 DEFAULT_STREAM_CHUNK_SIZE = 500; // Actors per chunk when get_scene_info is streamed
+    constexpr int64 STREAM_MAX_UNSENT_BYTES = 4 * 1024 * 1024; // A stream pauses while its client has this many response bytes unread
+    constexpr int32 JSON_STRUCTURAL_INDEX_THRESHOLD = 64 * 1024; // JSON requests this large are indexed before parsing
     
     // Path constants - use these instead of hardcoded paths
     // These will be initialized at runtime in the module startup
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPCommandTraits.h"
+#include <atomic>
+
+class IMCPCommandHandler;
+class FJsonObject;
+class FSocket;
+
+/**
+ * Running totals for one command, shared by every dispatch table built while it is registered
+ * Updated with relaxed atomics so any thread can record a dispatch
+ */
+struct FMCPCommandStats
+{
+    /** Number of times the command has been dispatched */
+    std::atomic<uint64> Dispatches{0};
+
+    /** Total time spent executing the command, in microseconds */
+    std::atomic<uint64> TotalMicroseconds{0};
+
+    /**
+     * Count one dispatch
+     * @param Seconds - How long the command took to execute
+     */
+    void Record(double Seconds)
+    {
+        Dispatches.fetch_add(1, std::memory_order_relaxed);
+        TotalMicroseconds.fetch_add(uint64(FMath::Max(Seconds, 0.0) * 1000000.0), std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Immutable command lookup table, rebuilt whenever a handler is registered or unregistered
+ * An open-addressed hash table at most half full, so a lookup hashes the name once and almost
+ * always probes a single slot however many extension commands are registered. Names match
+ * case-insensitively, as the handler map's FString keys always have.
+ */
+class UNREALARCHITECT_API FMCPDispatchTable
+{
+public:
+    /** A registered command */
+    struct FEntry
+    {
+        /** Command name as registered */
+        FString Name;
+
+        /** Command name as UTF-8, which is what lookups compare */
+        TArray<uint8> Utf8Name;
+
+        /** Hash of the lower-cased UTF-8 name */
+        uint32 Hash;
+
+        /** The command's handler */
+        TSharedPtr<IMCPCommandHandler> Handler;
+
+        /** What the handler declared about itself when it was registered */
+        FMCPCommandTraits Traits;
+
+        /** The command's counters */
+        TSharedRef<FMCPCommandStats> Stats;
+
+        /**
+         * Execute the command and count the dispatch
+         * @param Params - The command parameters
+         * @param ClientSocket - The client socket
+         * @return The handler's response
+         */
+        TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) const;
+    };
+
+    /**
+     * Build a table
+     * @param Handlers - Handlers by command name
+     * @param Stats - Counters by command name; must have an entry for every handler
+     */
+    FMCPDispatchTable(const TMap<FString, TSharedPtr<IMCPCommandHandler>>& Handlers, const TMap<FString, TSharedRef<FMCPCommandStats>>& Stats);
+
+    /**
+     * Look up a command by name
+     * @param Name - The command name
+     * @return The entry, or nullptr if no handler is registered for the name
+     */
+    const FEntry* Find(FStringView Name) const;
+
+    /** Get every registered command */
+    const TArray<FEntry>& GetEntries() const { return Entries; }
+
+private:
+    /**
+     * Look up a command by its UTF-8 name
+     * @param Name - The UTF-8 bytes of the name
+     * @param Length - Number of bytes
+     * @return The entry, or nullptr if no handler is registered for the name
+     */
+    const FEntry* FindUtf8(const uint8* Name, int32 Length) const;
+
+    /** Registered commands */
+    TArray<FEntry> Entries;
+
+    /** Index into Entries for each slot, INDEX_NONE when empty; the size is a power of two */
+    TArray<int32> Slots;
+};
@@ -27,14 +27,24 @@ public:
      * Constructor
      * @param InCommandName - The command name this handler responds to
      * @param InExecuteDelegate - The delegate to execute when this command is received
+     * @param InTraits - What the command declares about itself
      */
-    FMCPExtensionHandler(const FString& InCommandName, const FMCPCommandExecuteDelegate& InExecuteDelegate)
+    FMCPExtensionHandler(const FString& InCommandName, const FMCPCommandExecuteDelegate& InExecuteDelegate, const FMCPCommandTraits& InTraits = FMCPCommandTraits())
         : CommandName(InCommandName)
         , ExecuteDelegate(InExecuteDelegate)
+        , Traits(InTraits)
     {
     }
 
-    
+    /**
+     * Get what the command declares about itself
+     * @return The command's traits
+     */
+    virtual FMCPCommandTraits GetTraits() const override
+    {
+        return Traits;
+    }
+
 
     /**
      * Get the command name this handler responds to
@@ -72,6 +82,9 @@ private:
     
     /** The delegate to execute when this command is received */
     FMCPCommandExecuteDelegate ExecuteDelegate;
+    
+    /** What the command declares about itself */
+    FMCPCommandTraits Traits;
 };
 
 /**
@@ -85,9 +98,11 @@ public:
      * @param Server - The MCP server
      * @param CommandName - The name of the command to register
      * @param ExecuteDelegate - The delegate to execute when the command is received
+     * @param Traits - What the command declares about itself; the defaults suit a command that edits the scene
      * @return True if registration was successful
      */
-    static bool RegisterCommand(FMCPTCPServer* Server, const FString& CommandName, const FMCPCommandExecuteDelegate& ExecuteDelegate)
+    static bool RegisterCommand(FMCPTCPServer* Server, const FString& CommandName, const FMCPCommandExecuteDelegate& ExecuteDelegate,
+        const FMCPCommandTraits& Traits = FMCPCommandTraits())
     {
         if (!Server)
         {
@@ -95,7 +110,7 @@ public:
         }
         
         // Create a handler with the delegate
-        TSharedPtr<FMCPExtensionHandler> Handler = MakeShared<FMCPExtensionHandler>(CommandName, ExecuteDelegate);
+        TSharedPtr<FMCPExtensionHandler> Handler = MakeShared<FMCPExtensionHandler>(CommandName, ExecuteDelegate, Traits);
         
         // Register the handler with the server
         return Server->RegisterExternalCommandHandler(Handler);
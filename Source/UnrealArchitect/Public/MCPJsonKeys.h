@@ -0,0 +1,145 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * A JSON field name whose string and hash are built once
+ * FJsonObject keeps its fields in a TMap keyed by FString, so every SetStringField("status", ...)
+ * converts the literal into a new FString and hashes it, and every lookup hashes the name again.
+ * Going through FindByHash/AddByHash with a key from MCPJsonKeys skips both.
+ */
+struct UNREALARCHITECT_API FMCPJsonKey
+{
+    explicit FMCPJsonKey(const TCHAR* InName)
+        : Name(InName)
+        , Hash(GetTypeHash(Name))
+    {
+    }
+
+    /**
+     * Look up this field
+     * @param Object - The object to search
+     * @return The field's value, or nullptr if it is not set
+     */
+    TSharedPtr<FJsonValue> Find(const FJsonObject& Object) const
+    {
+        const TSharedPtr<FJsonValue>* Value = Object.Values.FindByHash(Hash, Name);
+        return Value ? *Value : nullptr;
+    }
+
+    /**
+     * Set this field, replacing any existing value
+     * @param Object - The object to modify
+     * @param Value - The new value
+     */
+    void Set(FJsonObject& Object, const TSharedPtr<FJsonValue>& Value) const
+    {
+        Object.Values.AddByHash(Hash, Name, Value);
+    }
+
+    /**
+     * Read this field as a string
+     * @param Object - The object to search
+     * @param OutString - Receives the string
+     * @return False if the field is missing or not a string
+     */
+    bool TryGetString(const FJsonObject& Object, FString& OutString) const
+    {
+        const TSharedPtr<FJsonValue> Value = Find(Object);
+        return Value.IsValid() && Value->Type == EJson::String && Value->TryGetString(OutString);
+    }
+
+    /**
+     * Read this field as an object
+     * @param Object - The object to search
+     * @param OutObject - Receives the nested object
+     * @return False if the field is missing or not an object
+     */
+    bool TryGetObject(const FJsonObject& Object, TSharedPtr<FJsonObject>& OutObject) const
+    {
+        const TSharedPtr<FJsonValue> Value = Find(Object);
+        if (!Value.IsValid() || Value->Type != EJson::Object)
+        {
+            return false;
+        }
+        OutObject = Value->AsObject();
+        return OutObject.IsValid();
+    }
+
+    /**
+     * Read this field as an array
+     * @param Object - The object to search
+     * @param OutArray - Receives a pointer to the array, owned by the field's value
+     * @return False if the field is missing or not an array
+     */
+    bool TryGetArray(const FJsonObject& Object, const TArray<TSharedPtr<FJsonValue>>*& OutArray) const
+    {
+        const TSharedPtr<FJsonValue>* Value = Object.Values.FindByHash(Hash, Name);
+        return Value && Value->IsValid() && (*Value)->Type == EJson::Array && (*Value)->TryGetArray(OutArray);
+    }
+
+    /**
+     * Read this field as a boolean
+     * @param Object - The object to search
+     * @param bOutValue - Receives the value
+     * @return False if the field is missing or not a boolean
+     */
+    bool TryGetBool(const FJsonObject& Object, bool& bOutValue) const
+    {
+        const TSharedPtr<FJsonValue> Value = Find(Object);
+        return Value.IsValid() && Value->Type == EJson::Boolean && Value->TryGetBool(bOutValue);
+    }
+
+    /** The field name */
+    const FString Name;
+
+    /** GetTypeHash(Name), as FJsonObject's map computes it */
+    const uint32 Hash;
+};
+
+/**
+ * Field names used by the protocol envelope and common to many handlers
+ */
+namespace MCPJsonKeys
+{
+    extern UNREALARCHITECT_API const FMCPJsonKey Type;
+    extern UNREALARCHITECT_API const FMCPJsonKey Params;
+    extern UNREALARCHITECT_API const FMCPJsonKey Id;
+    extern UNREALARCHITECT_API const FMCPJsonKey Status;
+    extern UNREALARCHITECT_API const FMCPJsonKey Message;
+    extern UNREALARCHITECT_API const FMCPJsonKey Result;
+    extern UNREALARCHITECT_API const FMCPJsonKey Stream;
+    extern UNREALARCHITECT_API const FMCPJsonKey Seq;
+    extern UNREALARCHITECT_API const FMCPJsonKey Chunks;
+    extern UNREALARCHITECT_API const FMCPJsonKey Name;
+    extern UNREALARCHITECT_API const FMCPJsonKey Location;
+    extern UNREALARCHITECT_API const FMCPJsonKey Rotation;
+    extern UNREALARCHITECT_API const FMCPJsonKey Scale;
+    extern UNREALARCHITECT_API const FMCPJsonKey RetryAfterMs;
+
+    /** Shared "success" status value; JSON values are immutable, so every response can reference it */
+    extern UNREALARCHITECT_API const TSharedRef<FJsonValue> StatusSuccess;
+
+    /** Shared "error" status value */
+    extern UNREALARCHITECT_API const TSharedRef<FJsonValue> StatusError;
+
+    /** Shared "busy" status value, for requests refused by admission control */
+    extern UNREALARCHITECT_API const TSharedRef<FJsonValue> StatusBusy;
+
+    /**
+     * Build an error response
+     * @param ErrorMessage - The error message
+     * @return {"status": "error", "message": ErrorMessage}
+     */
+    UNREALARCHITECT_API TSharedRef<FJsonObject> MakeErrorResponse(const FString& ErrorMessage);
+
+    /**
+     * Build a response refusing a request that the client may retry later
+     * @param Reason - Why the request was refused
+     * @param RetryAfterSeconds - How long the client should wait before retrying
+     * @return {"status": "busy", "message": Reason, "retry_after_ms": RetryAfterSeconds in milliseconds}
+     */
+    UNREALARCHITECT_API TSharedRef<FJsonObject> MakeBusyResponse(const FString& Reason, double RetryAfterSeconds);
+}
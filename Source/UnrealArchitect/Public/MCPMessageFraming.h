@@ -0,0 +1,148 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPConstants.h"
+
+class FMCPBufferPool;
+
+/**
+ * How messages are delimited on a client connection
+ */
+enum class EMCPFramingMode : uint8
+{
+    /** Decide from the first byte received: '{' or whitespace selects Json, anything else LengthPrefixed */
+    Auto,
+    
+    /** A message ends where its top-level JSON object closes; whitespace and newlines between messages are ignored */
+    Json,
+    
+    /** A message ends at the next '\n' */
+    NewlineDelimited,
+    
+    /** Each message is preceded by its size as a big-endian uint32 */
+    LengthPrefixed
+};
+
+/**
+ * Result of asking a framer for the next message
+ */
+enum class EMCPFrameResult : uint8
+{
+    /** No complete message is buffered yet */
+    NeedMoreData,
+    
+    /** A complete message was returned */
+    Message,
+    
+    /** The stream is malformed and the connection should be closed */
+    Error
+};
+
+/**
+ * Per-connection reassembly buffer
+ * Accumulates received bytes and splits them into complete messages, regardless of
+ * how the stream was segmented by TCP
+ */
+class UNREALARCHITECT_API FMCPMessageFramer
+{
+public:
+    /**
+     * Constructor
+     * @param InMode - The framing mode to use
+     * @param InMaxMessageSize - Largest message accepted before the stream is considered malformed
+     * @param InBufferPool - Pool to borrow the reassembly buffer from while data is buffered, nullptr to own it outright
+     */
+    explicit FMCPMessageFramer(EMCPFramingMode InMode = EMCPFramingMode::Auto, int32 InMaxMessageSize = MCPConstants::DEFAULT_MAX_MESSAGE_SIZE,
+        FMCPBufferPool* InBufferPool = nullptr);
+    
+    /**
+     * Append received bytes to the reassembly buffer
+     * @param Data - The received bytes
+     * @param Num - Number of bytes received
+     */
+    void Append(const uint8* Data, int32 Num);
+    
+    /**
+     * Extract the next complete message, if any
+     * @param OutMessage - Receives the message payload, without framing
+     * @return Whether a message was extracted, more data is needed, or the stream is malformed
+     */
+    EMCPFrameResult Next(TArray<uint8>& OutMessage);
+    
+    /**
+     * Add the framing for this connection's mode to an outgoing payload
+     * @param Payload - The payload to frame, modified in place
+     */
+    void FrameOutgoing(TArray<uint8>& Payload) const;
+    
+    /**
+     * Compress outgoing payloads of at least the given size
+     * Only length-prefixed connections can carry compressed frames; other modes ignore this
+     * @param InThreshold - Smallest payload to compress, in bytes (0 = never compress)
+     */
+    void SetCompressionThreshold(int32 InThreshold) { CompressionThreshold = InThreshold; }
+    
+    /**
+     * Get the framing mode, which is only resolved from Auto once data has arrived
+     * @return The framing mode
+     */
+    EMCPFramingMode GetMode() const { return Mode; }
+    
+    /**
+     * Get a description of the last framing error
+     * @return The error message
+     */
+    const FString& GetError() const { return Error; }
+    
+    /**
+     * Get the number of buffered bytes not yet returned as messages
+     * @return The number of buffered bytes
+     */
+    int32 GetBufferedBytes() const { return Buffer.Num() - ReadOffset; }
+    
+    /**
+     * Give the reassembly buffer back to the pool, discarding any buffered bytes
+     * Call once GetBufferedBytes() is 0, or when the connection closes
+     */
+    void ReleaseBuffer();
+
+private:
+    EMCPFrameResult NextJson(TArray<uint8>& OutMessage);
+    EMCPFrameResult NextNewlineDelimited(TArray<uint8>& OutMessage);
+    EMCPFrameResult NextLengthPrefixed(TArray<uint8>& OutMessage);
+    
+    /** Copy a message out of the buffer and consume it */
+    void ExtractMessage(int32 Start, int32 Num, int32 ConsumedEnd, TArray<uint8>& OutMessage);
+    
+    /** Fail the stream with a message */
+    EMCPFrameResult Fail(const FString& InError);
+    
+    /** Framing mode */
+    EMCPFramingMode Mode;
+    
+    /** Largest message accepted */
+    int32 MaxMessageSize;
+    
+    /** Smallest outgoing payload that is compressed, 0 if compression is off */
+    int32 CompressionThreshold;
+    
+    /** Pool the reassembly buffer is borrowed from, nullptr to allocate it directly */
+    FMCPBufferPool* BufferPool;
+    
+    /** Received bytes; everything before ReadOffset has already been consumed */
+    TArray<uint8> Buffer;
+    
+    /** Start of the unconsumed data in Buffer */
+    int32 ReadOffset;
+    
+    /** Where the next scan resumes, so partial messages are not rescanned */
+    int32 ScanOffset;
+    
+    /** Json mode scanner state */
+    int32 Depth;
+    bool bInString;
+    bool bEscaped;
+    
+    /** Last error */
+    FString Error;
+};
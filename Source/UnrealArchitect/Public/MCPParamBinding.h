@@ -0,0 +1,245 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPJsonKeys.h"
+
+/**
+ * Whether a bound parameter must be present
+ */
+enum class EMCPParamPresence : uint8
+{
+    /** Binding fails with a "Missing" error when the field is absent or null */
+    Required,
+
+    /** The member keeps its default when the field is absent or null */
+    Optional
+};
+
+/**
+ * Conversions from JSON values to the C++ types a params struct may use
+ * Each ReadValue overload succeeds only for a value of exactly the expected shape, and the
+ * matching DescribeType names that shape for validation errors.
+ */
+namespace MCPParamBinding
+{
+    inline bool ReadValue(const FJsonValue& Value, FString& OutValue)
+    {
+        return Value.Type == EJson::String && Value.TryGetString(OutValue);
+    }
+
+    inline bool ReadValue(const FJsonValue& Value, bool& bOutValue)
+    {
+        return Value.Type == EJson::Boolean && Value.TryGetBool(bOutValue);
+    }
+
+    inline bool ReadValue(const FJsonValue& Value, double& OutValue)
+    {
+        if (Value.Type != EJson::Number)
+        {
+            return false;
+        }
+        OutValue = Value.AsNumber();
+        return true;
+    }
+
+    inline bool ReadValue(const FJsonValue& Value, float& OutValue)
+    {
+        double Number;
+        if (!ReadValue(Value, Number))
+        {
+            return false;
+        }
+        OutValue = static_cast<float>(Number);
+        return true;
+    }
+
+    inline bool ReadValue(const FJsonValue& Value, int32& OutValue)
+    {
+        double Number;
+        if (!ReadValue(Value, Number) || Number != FMath::TruncToDouble(Number) || Number < MIN_int32 || Number > MAX_int32)
+        {
+            return false;
+        }
+        OutValue = static_cast<int32>(Number);
+        return true;
+    }
+
+    /** Read a [x, y, z] array */
+    inline bool ReadTriple(const FJsonValue& Value, double& OutX, double& OutY, double& OutZ)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Elements = nullptr;
+        if (Value.Type != EJson::Array || !Value.TryGetArray(Elements) || Elements->Num() != 3)
+        {
+            return false;
+        }
+        return (*Elements)[0].IsValid() && ReadValue(*(*Elements)[0], OutX)
+            && (*Elements)[1].IsValid() && ReadValue(*(*Elements)[1], OutY)
+            && (*Elements)[2].IsValid() && ReadValue(*(*Elements)[2], OutZ);
+    }
+
+    inline bool ReadValue(const FJsonValue& Value, FVector& OutValue)
+    {
+        return ReadTriple(Value, OutValue.X, OutValue.Y, OutValue.Z);
+    }
+
+    /** Rotators are sent as [pitch, yaw, roll] */
+    inline bool ReadValue(const FJsonValue& Value, FRotator& OutValue)
+    {
+        return ReadTriple(Value, OutValue.Pitch, OutValue.Yaw, OutValue.Roll);
+    }
+
+    inline bool ReadValue(const FJsonValue& Value, TArray<FString>& OutValue)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Elements = nullptr;
+        if (Value.Type != EJson::Array || !Value.TryGetArray(Elements))
+        {
+            return false;
+        }
+
+        OutValue.Reset(Elements->Num());
+        for (const TSharedPtr<FJsonValue>& Element : *Elements)
+        {
+            if (!Element.IsValid() || !ReadValue(*Element, OutValue.AddDefaulted_GetRef()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Nested objects are passed through for handlers that interpret them themselves */
+    inline bool ReadValue(const FJsonValue& Value, TSharedPtr<FJsonObject>& OutValue)
+    {
+        if (Value.Type != EJson::Object)
+        {
+            return false;
+        }
+        OutValue = Value.AsObject();
+        return OutValue.IsValid();
+    }
+
+    inline const TCHAR* DescribeType(const FString*) { return TEXT("a string"); }
+    inline const TCHAR* DescribeType(const bool*) { return TEXT("a boolean"); }
+    inline const TCHAR* DescribeType(const double*) { return TEXT("a number"); }
+    inline const TCHAR* DescribeType(const float*) { return TEXT("a number"); }
+    inline const TCHAR* DescribeType(const int32*) { return TEXT("an integer"); }
+    inline const TCHAR* DescribeType(const FVector*) { return TEXT("an array of 3 numbers"); }
+    inline const TCHAR* DescribeType(const FRotator*) { return TEXT("an array of 3 numbers (pitch, yaw, roll)"); }
+    inline const TCHAR* DescribeType(const TArray<FString>*) { return TEXT("an array of strings"); }
+    inline const TCHAR* DescribeType(const TSharedPtr<FJsonObject>*) { return TEXT("an object"); }
+}
+
+/**
+ * Field descriptors for a command's params struct
+ * Built once per struct, usually as a function-local static returned by TParams::GetSchema().
+ * Binding looks each described field up by its precomputed key hash, converts it straight into
+ * the struct member and stops at the first problem with a uniform error message, so handlers
+ * no longer repeat lookup and validation code.
+ *
+ *     static const TMCPParamSchema<FMyParams> Schema = TMCPParamSchema<FMyParams>()
+ *         .Add(TEXT("name"), &FMyParams::Name)
+ *         .Add(TEXT("location"), &FMyParams::Location, EMCPParamPresence::Optional);
+ */
+template <typename TParams>
+class TMCPParamSchema
+{
+public:
+    /**
+     * Describe a field stored directly in a member
+     * @param Name - The JSON field name
+     * @param Member - The member that receives the value
+     * @param Presence - Whether the field must be present; optional members keep their default
+     * @return This schema, for chaining
+     */
+    template <typename TValue>
+    TMCPParamSchema& Add(const TCHAR* Name, TValue TParams::* Member, EMCPParamPresence Presence = EMCPParamPresence::Required)
+    {
+        Fields.Emplace(Name, Presence, MCPParamBinding::DescribeType(static_cast<const TValue*>(nullptr)),
+            [Member](const FJsonValue& Value, TParams& OutParams)
+            {
+                return MCPParamBinding::ReadValue(Value, OutParams.*Member);
+            });
+        return *this;
+    }
+
+    /**
+     * Describe an optional field whose presence the handler needs to know about
+     * @param Name - The JSON field name
+     * @param Member - The member that is set only when the field is present
+     * @return This schema, for chaining
+     */
+    template <typename TValue>
+    TMCPParamSchema& Add(const TCHAR* Name, TOptional<TValue> TParams::* Member)
+    {
+        Fields.Emplace(Name, EMCPParamPresence::Optional, MCPParamBinding::DescribeType(static_cast<const TValue*>(nullptr)),
+            [Member](const FJsonValue& Value, TParams& OutParams)
+            {
+                TValue Read{};
+                if (!MCPParamBinding::ReadValue(Value, Read))
+                {
+                    return false;
+                }
+                (OutParams.*Member).Emplace(MoveTemp(Read));
+                return true;
+            });
+        return *this;
+    }
+
+    /**
+     * Fill a params struct from a command's params object
+     * @param Params - The command parameters
+     * @param OutParams - The struct to fill
+     * @param OutError - Receives a message naming the offending field on failure
+     * @return True if every described field was present when required and of the right shape
+     */
+    bool Bind(const FJsonObject& Params, TParams& OutParams, FString& OutError) const
+    {
+        for (const FField& Field : Fields)
+        {
+            const TSharedPtr<FJsonValue>* Value = Params.Values.FindByHash(Field.Key.Hash, Field.Key.Name);
+            if (!Value || !Value->IsValid() || (*Value)->IsNull())
+            {
+                if (Field.Presence == EMCPParamPresence::Required)
+                {
+                    OutError = FString::Printf(TEXT("Missing '%s' field"), *Field.Key.Name);
+                    return false;
+                }
+                continue;
+            }
+
+            if (!Field.Read(**Value, OutParams))
+            {
+                OutError = FString::Printf(TEXT("Invalid '%s' field: expected %s"), *Field.Key.Name, Field.Expected);
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct FField
+    {
+        FField(const TCHAR* InName, EMCPParamPresence InPresence, const TCHAR* InExpected, TFunction<bool(const FJsonValue&, TParams&)>&& InRead)
+            : Key(InName)
+            , Presence(InPresence)
+            , Expected(InExpected)
+            , Read(MoveTemp(InRead))
+        {
+        }
+
+        /** Field name and its hash */
+        FMCPJsonKey Key;
+
+        /** Whether the field must be present */
+        EMCPParamPresence Presence;
+
+        /** Description of the expected shape, for errors */
+        const TCHAR* Expected;
+
+        /** Converts the field's value into its member */
+        TFunction<bool(const FJsonValue&, TParams&)> Read;
+    };
+
+    /** Described fields, in the order they are validated */
+    TArray<FField> Fields;
+};
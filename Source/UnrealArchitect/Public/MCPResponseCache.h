@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "MCPConstants.h"
+#include <atomic>
+
+/**
+ * Recent responses of cacheable read-only commands, keyed by command and parameters
+ * Any command that is not read-only invalidates the whole cache, since the server cannot tell
+ * which queries a mutation affects. Entries also expire, which bounds how stale a result can be
+ * after edits made in the editor rather than through MCP.
+ */
+class UNREALARCHITECT_API FMCPResponseCache
+{
+public:
+    /**
+     * Constructor
+     * @param InMaxEntries - Most responses kept at once
+     */
+    explicit FMCPResponseCache(int32 InMaxEntries = MCPConstants::RESPONSE_CACHE_MAX_ENTRIES);
+
+    /**
+     * Look up a response
+     * @param CommandName - The command name
+     * @param Params - The command parameters
+     * @param Now - The current time, in FPlatformTime::Seconds
+     * @return A copy of the cached response that the caller may modify, or nullptr on a miss
+     */
+    TSharedPtr<FJsonObject> Find(const FString& CommandName, const TSharedPtr<FJsonObject>& Params, double Now);
+
+    /**
+     * Remember a response
+     * @param CommandName - The command name
+     * @param Params - The command parameters
+     * @param Response - The response, copied before it is stored
+     * @param ExpiryTime - When the response stops being reusable, in FPlatformTime::Seconds
+     */
+    void Add(const FString& CommandName, const TSharedPtr<FJsonObject>& Params, const TSharedRef<FJsonObject>& Response, double ExpiryTime);
+
+    /** Drop every cached response */
+    void Invalidate();
+
+    /** @return Number of lookups answered from the cache */
+    uint64 GetHits() const { return Hits.load(std::memory_order_relaxed); }
+
+    /** @return Number of lookups that missed */
+    uint64 GetMisses() const { return Misses.load(std::memory_order_relaxed); }
+
+private:
+    struct FEntry
+    {
+        /** The command name and encoded parameters, compared on lookup since keys are hashes */
+        TArray<uint8> Key;
+
+        /** The cached response */
+        TSharedRef<FJsonObject> Response;
+
+        /** When the entry stops being reusable */
+        double ExpiryTime;
+    };
+
+    /**
+     * Build the lookup key for a request
+     * @param CommandName - The command name
+     * @param Params - The command parameters
+     * @param OutKey - Receives the key bytes
+     * @return Hash of the key
+     */
+    static uint64 MakeKey(const FString& CommandName, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& OutKey);
+
+    /** Cached responses by key hash */
+    TMap<uint64, FEntry> Entries;
+
+    /** Most responses kept at once */
+    int32 MaxEntries;
+
+    /** Lookup counters, readable from any thread */
+    std::atomic<uint64> Hits{0};
+    std::atomic<uint64> Misses{0};
+
+    /** Guards Entries */
+    FCriticalSection Lock;
+};
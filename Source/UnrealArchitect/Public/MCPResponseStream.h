@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPTCPServer.h"
+
+/**
+ * Sends one command's result as a sequence of messages instead of a single response
+ *
+ * A stream is a "begin" frame carrying a header, any number of "chunk" frames and an
+ * "end" frame carrying a trailer. Every frame echoes the request's "id" and is queued
+ * to the I/O thread as soon as it is emitted. The server advances a stream one step per
+ * tick within the frame budget, and pauses it while the client has not read what was
+ * already sent, so a huge result is serialized piece by piece in bounded memory.
+ */
+class UNREALARCHITECT_API FMCPResponseStream
+{
+public:
+    /**
+     * Constructor
+     * @param InServer - The server that sends the frames
+     * @param InContext - The request being answered
+     */
+    FMCPResponseStream(FMCPTCPServer& InServer, const FMCPRequestContext& InContext);
+
+    /**
+     * Send the begin frame
+     * @param Header - Optional fields describing the whole result, e.g. a total count
+     */
+    void Begin(const TSharedPtr<FJsonObject>& Header = nullptr);
+
+    /**
+     * Send the next part of the result, beginning the stream first if needed
+     * @param Chunk - The part of the result
+     */
+    void SendChunk(const TSharedPtr<FJsonObject>& Chunk);
+
+    /**
+     * Send the end frame, beginning the stream first if needed
+     * @param Trailer - Optional fields summarising the result
+     */
+    void End(const TSharedPtr<FJsonObject>& Trailer = nullptr);
+
+    /**
+     * End the stream with an error, discarding nothing already sent
+     * @param Message - The error message
+     */
+    void Fail(const FString& Message);
+
+    /**
+     * Check whether the end frame has been sent
+     * @return True once End or Fail has been called
+     */
+    bool IsFinished() const { return bFinished; }
+
+    /**
+     * Get the number of chunks sent so far
+     * @return The chunk count
+     */
+    int32 GetNumChunks() const { return NumChunks; }
+
+    /**
+     * Get the request being answered
+     * @return The request's context
+     */
+    const FMCPRequestContext& GetContext() const { return Context; }
+
+private:
+    /** Build a frame of the given kind addressed to this stream */
+    TSharedPtr<FJsonObject> MakeFrame(const TCHAR* Kind) const;
+
+    /** The server that sends the frames */
+    FMCPTCPServer& Server;
+
+    /** The request being answered */
+    FMCPRequestContext Context;
+
+    /** Whether the begin frame has been sent */
+    bool bBegun;
+
+    /** Whether the end frame has been sent */
+    bool bFinished;
+
+    /** Number of chunk frames sent */
+    int32 NumChunks;
+};
+
+/**
+ * Produces a streamed result a step at a time, so it can be resumed on a later tick
+ */
+class IMCPStreamProducer
+{
+public:
+    virtual ~IMCPStreamProducer() {}
+
+    /**
+     * Send the next part of the result, typically one chunk, and end the stream after the last
+     * Called on the game thread until the stream is finished
+     * @param Stream - The stream being produced
+     */
+    virtual void Step(FMCPResponseStream& Stream) = 0;
+};
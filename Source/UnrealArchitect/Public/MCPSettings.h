@@ -11,4 +11,48 @@ class UNREALARCHITECT_API UMCPSettings : public UDeveloperSettings
 public:
     UPROPERTY(config, EditAnywhere, Category = "MCP", meta = (ClampMin = "1024", ClampMax = "65535"))
     int32 Port = MCPConstants::DEFAULT_PORT;
+    
+    /** Disconnect clients that send and receive nothing for this long (0 = never) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP|Timeouts", meta = (ClampMin = "0.0", Units = "Seconds"))
+    float IdleTimeoutSeconds = MCPConstants::DEFAULT_CLIENT_TIMEOUT_SECONDS;
+    
+    /** Disconnect clients that take longer than this to finish sending a request they have started (0 = unlimited) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP|Timeouts", meta = (ClampMin = "0.0", Units = "Seconds"))
+    float RequestTimeoutSeconds = MCPConstants::DEFAULT_REQUEST_TIMEOUT_SECONDS;
+    
+    /** Disconnect clients that leave a response unread for this long (0 = unlimited) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP|Timeouts", meta = (ClampMin = "0.0", Units = "Seconds"))
+    float WriteTimeoutSeconds = MCPConstants::DEFAULT_WRITE_TIMEOUT_SECONDS;
+    
+    /** Refuse connections beyond this many clients (0 = unlimited) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP|Limits", meta = (ClampMin = "0"))
+    int32 MaxConnections = MCPConstants::DEFAULT_MAX_CONNECTIONS;
+    
+    /** Answer "busy" to a client's requests while it already has this many queued or executing (0 = unlimited) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP|Limits", meta = (ClampMin = "0"))
+    int32 MaxInFlightRequests = MCPConstants::DEFAULT_MAX_IN_FLIGHT_REQUESTS;
+    
+    /** Command cost each client may spend per second, where a typical command costs 1; "busy" beyond it (0 = unlimited) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP|Limits", meta = (ClampMin = "0.0"))
+    float RateLimitPerSecond = MCPConstants::DEFAULT_RATE_LIMIT_PER_SECOND;
+    
+    /** Command cost a client may spend at once after being quiet */
+    UPROPERTY(config, EditAnywhere, Category = "MCP|Limits", meta = (ClampMin = "1.0"))
+    float RateLimitBurst = MCPConstants::DEFAULT_RATE_LIMIT_BURST;
+    
+    /** Game thread time spent executing queued commands per editor frame; the rest carries over (0 = unlimited) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP", meta = (ClampMin = "0.0", ClampMax = "1000.0", Units = "Milliseconds"))
+    float FrameBudgetMilliseconds = MCPConstants::DEFAULT_FRAME_BUDGET_MILLISECONDS;
+    
+    /** Run commands that never touch UObjects (e.g. benchmark_json_decode) on worker threads, outside the frame budget */
+    UPROPERTY(config, EditAnywhere, Category = "MCP")
+    bool bRunThreadSafeCommandsOnWorkers = true;
+    
+    /** Smallest response, in bytes, compressed for clients that negotiated compression (0 = never compress) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP", meta = (ClampMin = "0", Units = "Bytes"))
+    int32 CompressionThreshold = MCPConstants::DEFAULT_COMPRESSION_THRESHOLD;
+    
+    /** Also accept clients on this Unix domain socket, e.g. /tmp/unreal_architect.sock (Linux only, empty = TCP only) */
+    UPROPERTY(config, EditAnywhere, Category = "MCP")
+    FString UnixSocketPath;
 }; 
\ No newline at end of file
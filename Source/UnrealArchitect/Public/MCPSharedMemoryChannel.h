@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+#include "MCPAdmissionControl.h"
+
+/**
+ * Layout of the control block at the start of a shared memory channel
+ * The client owns WriteOffset and the server owns ReadOffset; both are byte offsets into
+ * an unbounded logical stream, mapped onto the data area modulo its capacity.
+ */
+struct FMCPSharedRingHeader
+{
+    /** MCPConstants::SHARED_RING_MAGIC once the server has initialised the channel */
+    uint32 Magic;
+
+    /** Layout version, currently 1 */
+    uint32 Version;
+
+    /** Size of the data area that follows the header, in bytes */
+    uint64 Capacity;
+
+    /** End of the data the client has written; advanced only by the client */
+    volatile int64 WriteOffset;
+
+    /** End of the data the server has consumed; advanced only by the server */
+    volatile int64 ReadOffset;
+};
+
+/**
+ * A named shared memory ring buffer that a local client writes bulk payloads into
+ * Payloads are referenced by offset in ordinary commands and decoded where they lie, so
+ * they never pass through a socket. A payload never wraps around the end of the data area;
+ * the client skips to the start instead.
+ */
+class UNREALARCHITECT_API FMCPSharedMemoryChannel
+{
+public:
+    /**
+     * Create and map a new channel
+     * @param Name - Name of the shared memory region
+     * @param Capacity - Size of the data area, in bytes
+     * @return The channel, or nullptr if the region could not be created
+     */
+    static TUniquePtr<FMCPSharedMemoryChannel> Create(const FString& Name, int32 Capacity);
+
+    ~FMCPSharedMemoryChannel();
+
+    /**
+     * Get a view of a payload the client has written
+     * @param Offset - Logical offset of the payload
+     * @param Length - Size of the payload, in bytes
+     * @param OutData - Receives the start of the payload in shared memory
+     * @return False if the range has not been written, was already consumed or wraps
+     */
+    bool View(int64 Offset, int32 Length, const uint8*& OutData) const;
+
+    /**
+     * Hand the space up to a logical offset back to the client
+     * @param EndOffset - End of the last payload processed
+     */
+    void Release(int64 EndOffset);
+
+    /** Get the name of the shared memory region */
+    const FString& GetName() const { return Name; }
+
+    /** Get the size of the data area, in bytes */
+    int32 GetCapacity() const { return Capacity; }
+
+    /** Get the offset of the data area from the start of the region, in bytes */
+    static constexpr int32 GetDataOffset() { return 64; }
+
+private:
+    FMCPSharedMemoryChannel(const FString& InName, FPlatformMemory::FSharedMemoryRegion* InRegion, int32 InCapacity);
+
+    /** Region name */
+    FString Name;
+
+    /** Mapped region */
+    FPlatformMemory::FSharedMemoryRegion* Region;
+
+    /** Control block at the start of the region */
+    FMCPSharedRingHeader* Header;
+
+    /** Start of the data area */
+    const uint8* Data;
+
+    /** Size of the data area */
+    int32 Capacity;
+};
+
+/**
+ * Shared memory channels opened by clients, owned by the game thread
+ */
+class UNREALARCHITECT_API FMCPSharedChannelRegistry
+{
+public:
+    /**
+     * Create a channel
+     * @param Capacity - Size of the data area, in bytes
+     * @param Owner - Admission state of the client connection the channel belongs to, nullptr if it has none
+     * @param OutId - Receives the id clients use to refer to the channel
+     * @return The channel, or nullptr on failure
+     */
+    FMCPSharedMemoryChannel* Open(int32 Capacity, const TSharedPtr<FMCPClientAdmission>& Owner, int32& OutId);
+
+    /**
+     * Find an open channel
+     * @param Id - The channel id
+     * @return The channel, or nullptr if no channel has that id
+     */
+    FMCPSharedMemoryChannel* Find(int32 Id) const;
+
+    /**
+     * Close and unmap a channel
+     * @param Id - The channel id
+     * @return False if no channel has that id
+     */
+    bool Close(int32 Id);
+
+    /**
+     * Close the channels of client connections that have gone away without closing them
+     * @return The number of channels closed
+     */
+    int32 CloseAbandoned();
+
+    /** Get the number of open channels */
+    int32 Num() const { return Channels.Num(); }
+
+private:
+    /** Open channels by id */
+    TMap<int32, TUniquePtr<FMCPSharedMemoryChannel>> Channels;
+
+    /** Connections that own channels, by channel id */
+    TMap<int32, TWeakPtr<FMCPClientAdmission>> Owners;
+
+    /** Id given to the next channel */
+    int32 NextId = 1;
+};
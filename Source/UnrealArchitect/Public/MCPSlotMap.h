@@ -0,0 +1,185 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Optional.h"
+
+/**
+ * Stable handle to an element of a TMCPSlotMap
+ * The generation detects handles that outlived their element, even after the slot is reused
+ */
+struct FMCPSlotHandle
+{
+    /** Slot index, INDEX_NONE for an unset handle */
+    int32 Index = INDEX_NONE;
+    
+    /** Generation of the slot when the handle was issued */
+    uint32 Generation = 0;
+    
+    bool IsSet() const { return Index != INDEX_NONE; }
+    
+    bool operator==(const FMCPSlotHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+    bool operator!=(const FMCPSlotHandle& Other) const { return !(*this == Other); }
+    
+    friend uint32 GetTypeHash(const FMCPSlotHandle& Handle)
+    {
+        return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+    }
+};
+
+/**
+ * Generation-indexed container with stable slots
+ * Elements never move when others are removed, so the current element can be removed
+ * while iterating. Adding may reallocate and must not happen during iteration.
+ */
+template<typename ElementType>
+class TMCPSlotMap
+{
+    struct FSlot
+    {
+        TOptional<ElementType> Element;
+        uint32 Generation = 0;
+    };
+
+public:
+    /**
+     * Add an element, reusing a free slot if there is one
+     * @param Element - The element to add
+     * @return Handle to the new element
+     */
+    FMCPSlotHandle Add(ElementType&& Element)
+    {
+        int32 Index;
+        if (FreeSlots.Num() > 0)
+        {
+            Index = FreeSlots.Pop(EAllowShrinking::No);
+        }
+        else
+        {
+            Index = Slots.AddDefaulted();
+        }
+        
+        FSlot& Slot = Slots[Index];
+        Slot.Element.Emplace(MoveTemp(Element));
+        ++NumElements;
+        
+        FMCPSlotHandle Handle;
+        Handle.Index = Index;
+        Handle.Generation = Slot.Generation;
+        return Handle;
+    }
+    
+    /**
+     * Remove an element; other elements and handles are unaffected
+     * @param Handle - Handle to the element
+     * @return True if the handle referred to a live element
+     */
+    bool Remove(const FMCPSlotHandle& Handle)
+    {
+        if (!Find(Handle))
+        {
+            return false;
+        }
+        
+        FSlot& Slot = Slots[Handle.Index];
+        Slot.Element.Reset();
+        ++Slot.Generation;
+        FreeSlots.Add(Handle.Index);
+        --NumElements;
+        return true;
+    }
+    
+    /**
+     * Find an element
+     * @param Handle - Handle to the element
+     * @return The element, or nullptr if the handle is stale
+     */
+    ElementType* Find(const FMCPSlotHandle& Handle)
+    {
+        if (!Slots.IsValidIndex(Handle.Index))
+        {
+            return nullptr;
+        }
+        
+        FSlot& Slot = Slots[Handle.Index];
+        return (Slot.Generation == Handle.Generation && Slot.Element.IsSet()) ? &Slot.Element.GetValue() : nullptr;
+    }
+    
+    const ElementType* Find(const FMCPSlotHandle& Handle) const
+    {
+        return const_cast<TMCPSlotMap*>(this)->Find(Handle);
+    }
+    
+    /** @return Number of live elements */
+    int32 Num() const { return NumElements; }
+    
+    /** Remove every element, invalidating all handles */
+    void Empty()
+    {
+        for (int32 Index = 0; Index < Slots.Num(); ++Index)
+        {
+            if (Slots[Index].Element.IsSet())
+            {
+                Remove(FMCPSlotHandle{ Index, Slots[Index].Generation });
+            }
+        }
+    }
+    
+    /**
+     * Iterator over live elements
+     * Removing the current element through the map is allowed
+     */
+    class TIterator
+    {
+    public:
+        explicit TIterator(TMCPSlotMap& InMap)
+            : Map(InMap)
+            , Index(-1)
+        {
+            Advance();
+        }
+        
+        TIterator& operator++()
+        {
+            Advance();
+            return *this;
+        }
+        
+        explicit operator bool() const { return Map.Slots.IsValidIndex(Index); }
+        
+        /** @return The current element, which must not have been removed */
+        ElementType& operator*() const { return Map.Slots[Index].Element.GetValue(); }
+        ElementType* operator->() const { return &Map.Slots[Index].Element.GetValue(); }
+        
+        /** @return Whether the current element is still live */
+        bool IsValid() const { return Map.Slots[Index].Element.IsSet(); }
+        
+        /** @return Handle to the current element */
+        FMCPSlotHandle GetHandle() const { return FMCPSlotHandle{ Index, Map.Slots[Index].Generation }; }
+        
+    private:
+        void Advance()
+        {
+            do
+            {
+                ++Index;
+            }
+            while (Index < Map.Slots.Num() && !Map.Slots[Index].Element.IsSet());
+        }
+        
+        TMCPSlotMap& Map;
+        int32 Index;
+    };
+    
+    /** @return Iterator over live elements */
+    TIterator CreateIterator() { return TIterator(*this); }
+
+private:
+    /** Slots, occupied or free */
+    TArray<FSlot> Slots;
+    
+    /** Indices of free slots, reused last-in first-out */
+    TArray<int32> FreeSlots;
+    
+    /** Number of occupied slots */
+    int32 NumElements = 0;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPSlotMap.h"
+
+class FSocket;
+
+/**
+ * Readiness reported for one socket by FMCPSocketPoller::Wait
+ */
+struct FMCPSocketEvent
+{
+    /** True if this event is for one of the listening sockets */
+    bool bListener = false;
+    
+    /** Connection the socket was registered with */
+    FMCPSlotHandle Connection;
+    
+    /** Data (or a pending connection) can be read */
+    bool bReadable = false;
+    
+    /** The send buffer has room again */
+    bool bWritable = false;
+    
+    /** The peer hung up or the socket failed */
+    bool bClosed = false;
+};
+
+/**
+ * Waits for socket readiness on the I/O thread
+ * The event-driven implementation only reports sockets that are ready, so idle connections
+ * cost nothing per iteration. The polling fallback reports nothing and the caller checks
+ * every socket itself.
+ */
+class FMCPSocketPoller
+{
+public:
+    virtual ~FMCPSocketPoller() {}
+    
+    /**
+     * Create the best poller available on this platform
+     * @param bPreferEventDriven - Whether to use epoll when it is available
+     * @return The poller, never null
+     */
+    static TUniquePtr<FMCPSocketPoller> Create(bool bPreferEventDriven);
+    
+    /**
+     * Whether Wait reports individual socket readiness
+     * @return False for the polling fallback
+     */
+    virtual bool IsEventDriven() const = 0;
+    
+    /**
+     * Watch a listening socket for pending connections
+     * Events for every listener are reported alike, so the caller checks all of them
+     * @param Socket - The listening socket
+     */
+    virtual void AddListener(FSocket* Socket) = 0;
+    
+    /**
+     * Watch a client socket for incoming data
+     * @param Socket - The client socket
+     * @param Connection - Handle reported back in events for this socket
+     */
+    virtual void Add(FSocket* Socket, const FMCPSlotHandle& Connection) = 0;
+    
+    /**
+     * Change whether a client socket is also watched for writability
+     * @param Socket - The client socket
+     * @param Connection - Handle the socket was added with
+     * @param bWantsWrite - True while the connection has unsent bytes
+     */
+    virtual void SetWantsWrite(FSocket* Socket, const FMCPSlotHandle& Connection, bool bWantsWrite) = 0;
+    
+    /**
+     * Stop watching a socket; must be called before the socket is destroyed
+     * @param Socket - The socket
+     */
+    virtual void Remove(FSocket* Socket) = 0;
+    
+    /**
+     * Block until a socket is ready, Wake is called or the timeout expires
+     * @param TimeoutSeconds - Longest time to block
+     * @param OutEvents - Receives one event per ready socket
+     */
+    virtual void Wait(float TimeoutSeconds, TArray<FMCPSocketEvent>& OutEvents) = 0;
+    
+    /**
+     * Interrupt a Wait in progress; safe to call from any thread
+     */
+    virtual void Wake() = 0;
+};
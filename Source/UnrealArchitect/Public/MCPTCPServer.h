@@ -1,12 +1,25 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Containers/Ticker.h"
+#include "Containers/Queue.h"
+#include "Tasks/Task.h"
 #include "Json.h"
 #include "Networking.h"
-#include "Common/TcpListener.h"
+#include "Common/TcpSocketBuilder.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "MCPConstants.h"
+#include "MCPMessageFraming.h"
+#include "MCPSlotMap.h"
+#include "MCPSocketPoller.h"
+#include "MCPWireEncoding.h"
+#include "MCPDispatchTable.h"
+#include "MCPTimerWheel.h"
+#include "MCPBufferPool.h"
+#include "MCPAdmissionControl.h"
+#include "MCPCommandTraits.h"
+#include "MCPResponseCache.h"
+#include <atomic>
 
 /**
  * Configuration struct for the TCP server
@@ -17,19 +30,67 @@ struct FMCPTCPServerConfig
     /** Port to listen on */
     int32 Port = MCPConstants::DEFAULT_PORT;
     
-    /** Client timeout in seconds */
+    /** Time without any traffic before a client is disconnected, in seconds (0 = never) */
     float ClientTimeoutSeconds = MCPConstants::DEFAULT_CLIENT_TIMEOUT_SECONDS;
     
-    /** Size of the receive buffer in bytes */
+    /** Time a client has to finish sending a request once its first bytes arrive, in seconds (0 = unlimited) */
+    float RequestTimeoutSeconds = MCPConstants::DEFAULT_REQUEST_TIMEOUT_SECONDS;
+    
+    /** Time queued response bytes may wait for the client to read them, in seconds (0 = unlimited) */
+    float WriteTimeoutSeconds = MCPConstants::DEFAULT_WRITE_TIMEOUT_SECONDS;
+    
+    /** Most concurrent client connections; further connections are refused (0 = unlimited) */
+    int32 MaxConnections = MCPConstants::DEFAULT_MAX_CONNECTIONS;
+    
+    /** Most requests one client may have queued or executing; further requests get a busy response (0 = unlimited) */
+    int32 MaxInFlightRequests = MCPConstants::DEFAULT_MAX_IN_FLIGHT_REQUESTS;
+    
+    /** Command cost one client may spend per second; commands beyond it get a busy response (0 = unlimited) */
+    float RateLimitPerSecond = MCPConstants::DEFAULT_RATE_LIMIT_PER_SECOND;
+    
+    /** Command cost one client may spend at once after being quiet */
+    float RateLimitBurst = MCPConstants::DEFAULT_RATE_LIMIT_BURST;
+    
+    /** Most bytes read from a socket at once, in bytes */
     int32 ReceiveBufferSize = MCPConstants::DEFAULT_RECEIVE_BUFFER_SIZE;
     
-    /** Tick interval in seconds */
+    /** How messages are delimited on client connections */
+    EMCPFramingMode FramingMode = EMCPFramingMode::Auto;
+    
+    /** Largest request accepted, in bytes */
+    int32 MaxMessageSize = MCPConstants::DEFAULT_MAX_MESSAGE_SIZE;
+    
+    /** Smallest response compressed for clients that negotiated compression, in bytes (0 = never compress) */
+    int32 CompressionThreshold = MCPConstants::DEFAULT_COMPRESSION_THRESHOLD;
+    
+    /** Interval at which the game thread drains pending commands, in seconds (0 = every frame) */
     float TickIntervalSeconds = MCPConstants::DEFAULT_TICK_INTERVAL_SECONDS;
     
+    /** Game thread time spent executing commands per tick, in milliseconds; the remainder carries over (0 = unlimited) */
+    float FrameBudgetMilliseconds = MCPConstants::DEFAULT_FRAME_BUDGET_MILLISECONDS;
+    
+    /** Run commands whose handlers are thread-safe on worker threads instead of the game thread */
+    bool bRunThreadSafeCommandsOnWorkers = true;
+    
+    /** Maximum time the I/O thread waits between socket polls, in seconds */
+    float IOWaitSeconds = MCPConstants::DEFAULT_IO_WAIT_SECONDS;
+    
+    /** Maximum time the I/O thread blocks waiting for socket events when event-driven, in seconds */
+    float IOEventWaitSeconds = MCPConstants::DEFAULT_IO_EVENT_WAIT_SECONDS;
+    
+    /** Whether to use readiness notification (epoll) instead of polling every socket, where available */
+    bool bUseEventPoller = MCPConstants::DEFAULT_USE_EVENT_POLLER;
+    
+    /** Path of an additional Unix domain socket listener for same-host clients (empty = TCP only; Linux only) */
+    FString UnixSocketPath;
+    
     /** Whether to log verbose messages */
     bool bEnableVerboseLogging = MCPConstants::DEFAULT_VERBOSE_LOGGING;
 };
 
+/** Handle to a client connection, stays unique after the connection is closed */
+using FMCPConnectionHandle = FMCPSlotHandle;
+
 /**
  * Structure to track client connection information
  */
@@ -38,30 +99,186 @@ struct FMCPClientConnection
     /** Socket for this client */
     FSocket* Socket;
     
+    /** Handle of this connection in the server's connection table */
+    FMCPConnectionHandle Handle;
+    
     /** Endpoint information */
     FIPv4Endpoint Endpoint;
     
-    /** Time since last activity for timeout tracking */
-    float TimeSinceLastActivity;
+    /** When bytes were last received from or written to this client, in FPlatformTime::Seconds */
+    double LastActivityTime;
+    
+    /** When the partially received request started arriving, 0 when there is none */
+    double RequestStartTime = 0.0;
+    
+    /** When the socket last accepted queued response bytes, 0 when nothing is queued */
+    double LastWriteProgressTime = 0.0;
+    
+    /** Earliest deadline this connection has a timer scheduled for */
+    double TimerDeadline = MAX_dbl;
+    
+    /** In-flight count and rate limit, shared with the requests this client has in flight */
+    TSharedPtr<FMCPClientAdmission> Admission;
     
-    /** Buffer for receiving data */
-    TArray<uint8> ReceiveBuffer;
+    /** Reassembles received bytes into complete messages; its buffer is only held while a request is partially received */
+    FMCPMessageFramer Framer;
+    
+    /** Framed responses waiting to be written, oldest first */
+    TArray<TArray<uint8>> OutboundQueue;
+    
+    /** Bytes of the first queued response that have already been written */
+    int32 OutboundOffset = 0;
+    
+    /** Bytes in OutboundQueue not yet written */
+    int64 OutboundBytes = 0;
+    
+    /** Whether the poller is watching this socket for writability */
+    bool bWantsWrite = false;
+    
+    /**
+     * Check whether any response bytes are still waiting to be written
+     * @return True if the outbound queue is not empty
+     */
+    bool HasPendingOutbound() const { return OutboundQueue.Num() > 0; }
 
     /**
      * Constructor
      * @param InSocket - The client socket
      * @param InEndpoint - The client endpoint
-     * @param BufferSize - Size of the receive buffer
+     * @param FramingMode - How messages are delimited on this connection
+     * @param MaxMessageSize - Largest request accepted, in bytes
+     * @param BufferPool - Pool the connection borrows its reassembly buffer from, nullptr to own it outright
      */
-    FMCPClientConnection(FSocket* InSocket, const FIPv4Endpoint& InEndpoint, int32 BufferSize = MCPConstants::DEFAULT_RECEIVE_BUFFER_SIZE)
+    FMCPClientConnection(FSocket* InSocket, const FIPv4Endpoint& InEndpoint, EMCPFramingMode FramingMode = EMCPFramingMode::Auto,
+        int32 MaxMessageSize = MCPConstants::DEFAULT_MAX_MESSAGE_SIZE, FMCPBufferPool* BufferPool = nullptr)
         : Socket(InSocket)
         , Endpoint(InEndpoint)
-        , TimeSinceLastActivity(0.0f)
+        , LastActivityTime(FPlatformTime::Seconds())
+        , Framer(FramingMode, MaxMessageSize, BufferPool)
     {
-        ReceiveBuffer.SetNumUninitialized(BufferSize);
     }
 };
 
+/**
+ * Identifies where a request came from, so its response can be routed back
+ */
+struct FMCPRequestContext
+{
+    /** Connection the request arrived on */
+    FMCPConnectionHandle Connection;
+    
+    /** Socket the request arrived on, passed through to handlers */
+    FSocket* ClientSocket = nullptr;
+    
+    /** Optional client-chosen "id" of the request, echoed in its response */
+    TSharedPtr<FJsonValue> RequestId;
+    
+    /** Encoding the request arrived in; its response is sent back the same way */
+    EMCPWireEncoding Encoding = EMCPWireEncoding::Json;
+    
+    /** Admission state of the client that sent the request, released when the request finishes */
+    TSharedPtr<FMCPClientAdmission> Admission;
+    
+    /** How many commands that run other commands (batch, shared_dispatch) this one is running inside */
+    int32 NestingDepth = 0;
+    
+    /** Whether the connection frames messages with a length prefix, the only framing that can carry compressed responses */
+    bool bLengthPrefixed = false;
+};
+
+/**
+ * A complete request read by the I/O thread, waiting to be executed on the game thread
+ */
+struct FMCPPendingCommand
+{
+    /** Where the request came from */
+    FMCPRequestContext Context;
+    
+    /** Request payload, as UTF-8 JSON or CBOR */
+    TArray<uint8> Payload;
+};
+
+/**
+ * A decoded request waiting for its turn on the game thread
+ */
+struct FMCPReadyCommand
+{
+    /** The decoded request envelope */
+    TSharedPtr<FJsonObject> Command;
+    
+    /** Where the request came from */
+    FMCPRequestContext Context;
+    
+    /** Queue the command was filed in, which can be later than its own priority */
+    EMCPCommandPriority Priority = EMCPCommandPriority::Normal;
+    
+    /** Whether the command changes editor state */
+    bool bEdit = false;
+    
+    /** Dispatch table the command was looked up in, which keeps Entry alive */
+    TSharedPtr<const FMCPDispatchTable> Table;
+    
+    /** The command's entry, or nullptr if its type is missing or unknown */
+    const FMCPDispatchTable::FEntry* Entry = nullptr;
+};
+
+/**
+ * Commands one connection has waiting in the ready queues, counted by queue
+ * A connection's edits are filed no earlier than anything it sent before them, and its queries no
+ * earlier than its pending edits, so priorities reorder work across clients but never a client's own edits
+ */
+struct FMCPConnectionBacklog
+{
+    /** Waiting commands of any kind */
+    int32 Commands[int32(EMCPCommandPriority::Num)] = {};
+    
+    /** Waiting commands that are not read-only */
+    int32 Edits[int32(EMCPCommandPriority::Num)] = {};
+};
+
+/**
+ * A serialized response waiting to be written by the I/O thread
+ */
+struct FMCPPendingResponse
+{
+    /** Connection the response is addressed to, unset if only the socket is known */
+    FMCPConnectionHandle Connection;
+    
+    /** Socket the response is addressed to */
+    FSocket* ClientSocket = nullptr;
+    
+    /** Encoded response payload; may be empty for a control entry */
+    TArray<uint8> Payload;
+    
+    /** Switch the connection to compressed responses before this payload is framed */
+    bool bEnableCompression = false;
+    
+    /** Admission state the payload's size was charged to while it waits in the queue */
+    TSharedPtr<FMCPClientAdmission> Admission;
+};
+
+class FMCPResponseStream;
+class IMCPStreamProducer;
+class FMCPSharedChannelRegistry;
+
+/**
+ * A streamed response that continues on later ticks (game thread)
+ */
+struct FMCPActiveStream
+{
+    /** The stream being produced, which also carries the request's context */
+    TSharedPtr<FMCPResponseStream> Stream;
+    
+    /** Sends the rest of the result */
+    TSharedPtr<IMCPStreamProducer> Producer;
+    
+    /** Counters of the command being streamed */
+    TSharedPtr<FMCPCommandStats> Stats;
+    
+    /** Time spent producing the stream so far, in seconds */
+    double ExecutionSeconds = 0.0;
+};
+
 /**
  * Interface for command handlers
  * Allows for easy addition of new commands without modifying the server
@@ -84,14 +301,53 @@ public:
      * @return JSON response object
      */
     virtual TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FSocket* ClientSocket) = 0;
+    
+    /**
+     * Describe the command, so the server can pick its thread, cache policy and priority
+     * Read once when the handler is registered
+     * @return The command's traits
+     */
+    virtual FMCPCommandTraits GetTraits() const { return FMCPCommandTraits(); }
+    
+    /**
+     * Check whether the handler can stream its result
+     * @return True if BeginStreaming is implemented
+     */
+    virtual bool SupportsStreaming() const { return false; }
+    
+    /**
+     * Start handling the command as a stream instead of returning the result (game thread)
+     * Only called for requests with "stream": true when SupportsStreaming returns true
+     * @param Params - The command parameters
+     * @param Stream - Receives the header, chunks and trailer
+     * @return Producer that continues the stream on later ticks, or nullptr if the stream was finished here
+     */
+    virtual TSharedPtr<IMCPStreamProducer> BeginStreaming(const TSharedPtr<FJsonObject>& Params, FMCPResponseStream& Stream) { return nullptr; }
+    
+    /**
+     * Get what a request costs against the client's rate limit
+     * Override when the cost depends on the parameters
+     * @param Params - The command parameters
+     * @return The cost; the traits' estimate by default
+     */
+    virtual double GetCost(const TSharedPtr<FJsonObject>& Params) const { return GetTraits().Cost; }
 };
 
+class FMCPServerIOThread;
+class FRunnableThread;
+
 /**
  * MCP TCP Server
  * Manages connections and command routing
+ * 
+ * Socket accept/recv/send runs on a dedicated I/O thread, which hands complete
+ * requests to the game thread through a lock-free queue. Commands are executed
+ * on the game thread and their responses are queued back to the I/O thread.
  */
 class UNREALARCHITECT_API FMCPTCPServer
 {
+    friend class FMCPServerIOThread;
+
 public:
     /**
      * Constructor
@@ -121,6 +377,12 @@ public:
      */
     bool IsRunning() const { return bRunning; }
     
+    /**
+     * Get the server configuration
+     * @return The configuration the server was created with
+     */
+    const FMCPTCPServerConfig& GetConfig() const { return Config; }
+    
     /**
      * Register a command handler
      * @param Handler - The handler to register
@@ -150,11 +412,123 @@ public:
 
     /**
      * Send a response to a client
+     * Serializes the response and queues it for the I/O thread, so it is safe to call from any thread
      * @param Client - The client socket
      * @param Response - The response to send
      */
     void SendResponse(FSocket* Client, const TSharedPtr<FJsonObject>& Response);
+    
+    /**
+     * Send a response to the client that made a request
+     * The request's "id", if it had one, is added to the response. Safe to call from any thread
+     * @param Context - The request being answered
+     * @param Response - The response to send
+     */
+    void SendResponse(const FMCPRequestContext& Context, const TSharedPtr<FJsonObject>& Response);
+    
+    /**
+     * Compress a client's responses from now on when they reach the configured threshold
+     * Takes effect in order with responses already sent. Safe to call from any thread
+     * @param Context - A request from the client, which identifies its connection
+     * @return False if compression is disabled in the server configuration or the connection is not length-prefixed
+     */
+    bool EnableResponseCompression(const FMCPRequestContext& Context);
 
+    /**
+     * Get the number of commands waiting to be executed on the game thread
+     * @return The queue depth
+     */
+    int32 GetPendingCommandCount() const { return PendingCommandCount.load(std::memory_order_relaxed); }
+    
+    /**
+     * Get the number of connected clients
+     * @return The number of client connections
+     */
+    int32 GetNumConnections() const { return NumConnections.load(std::memory_order_relaxed); }
+    
+    /**
+     * Get the number of thread-safe commands executing on worker threads
+     * @return The number of worker commands
+     */
+    int32 GetNumWorkerCommands() const { return NumWorkerCommands.load(std::memory_order_relaxed); }
+    
+    /**
+     * Get the number of commands executed by the last game thread tick
+     * @return The number of commands
+     */
+    int32 GetLastTickCommandCount() const { return LastTickCommandCount; }
+    
+    /**
+     * Get the game thread time spent executing commands in the last tick
+     * @return The time in milliseconds
+     */
+    double GetLastTickMilliseconds() const { return LastTickMilliseconds; }
+    
+    /**
+     * Get the number of requests refused with a busy response since the server started (thread-safe)
+     * @return The number of busy responses
+     */
+    int64 GetBusyResponseCount() const { return BusyResponseCount.load(std::memory_order_relaxed); }
+    
+    /**
+     * Get the cache of read-only command responses, e.g. to report its hit rate
+     * @return The cache
+     */
+    const FMCPResponseCache& GetResponseCache() const { return ResponseCache; }
+    
+    /**
+     * Get the request whose handler is executing on the calling thread
+     * Lets handlers tie state they create, such as shared channels, to the client that asked for it
+     * @return The request, or nullptr outside a command handler
+     */
+    static const FMCPRequestContext* GetExecutingRequest();
+    
+    /**
+     * Runs the commands a batch or shared_dispatch executes one nesting level deeper in the executing request
+     * Commands that run other commands refuse to do so when nested, so a client cannot recurse through them
+     */
+    class UNREALARCHITECT_API FNestedCommandScope
+    {
+    public:
+        FNestedCommandScope();
+        ~FNestedCommandScope();
+        
+        FNestedCommandScope(const FNestedCommandScope&) = delete;
+        FNestedCommandScope& operator=(const FNestedCommandScope&) = delete;
+        
+    private:
+        /** The executing request, one level deeper */
+        FMCPRequestContext Nested;
+        
+        /** The executing request to restore */
+        const FMCPRequestContext* Previous;
+    };
+    
+    /**
+     * Check whether the calling thread is executing a command run by a batch or shared_dispatch
+     * @return True if the executing request is nested
+     */
+    static bool IsExecutingNestedCommand();
+    
+    /**
+     * Get the pool of connection receive buffers, e.g. to report its memory use
+     * @return The pool; only its byte counts may be read outside the I/O thread
+     */
+    const FMCPBufferPool& GetReceiveBufferPool() const { return ReceiveBufferPool; }
+    
+    /**
+     * Look up the handler for a command in the current dispatch table (game thread)
+     * @param CommandName - The command name, matched case-insensitively
+     * @return The command's entry, or nullptr if no handler is registered for it
+     */
+    const FMCPDispatchTable::FEntry* FindCommand(FStringView CommandName) const { return DispatchTable->Find(CommandName); }
+    
+    /**
+     * Get the current dispatch table, e.g. to report per-command counters
+     * @return The table; it is replaced, never modified, when handlers change
+     */
+    TSharedRef<const FMCPDispatchTable> GetDispatchTable() const { return DispatchTable; }
+    
     /**
      * Get the command handlers map (for testing purposes)
      * @return The map of command handlers
@@ -163,34 +537,147 @@ public:
 
 protected:
     /**
-     * Tick function called by the ticker
+     * Tick function called by the ticker on the game thread
      * @param DeltaTime - Time since last tick
      * @return True to continue ticking
      */
     bool Tick(float DeltaTime);
     
     /**
-     * Process pending connections
+     * One iteration of the I/O thread loop
+     * @param DeltaTime - Time since the last iteration
+     */
+    virtual void TickIO(float DeltaTime);
+    
+    /**
+     * Execute the commands queued by the I/O thread within the frame budget (game thread)
+     * Commands that do not fit are left queued for the next tick
+     */
+    virtual void ProcessPendingCommands();
+    
+    /**
+     * Service the sockets the poller reported as ready (I/O thread, event-driven poller only)
+     */
+    virtual void ProcessSocketEvents();
+    
+    /**
+     * Accept pending connections (I/O thread)
      */
     virtual void ProcessPendingConnections();
     
     /**
-     * Process client data
+     * Check every client socket for data (I/O thread, polling fallback only)
      */
     virtual void ProcessClientData();
     
     /**
-     * Process a command
-     * @param CommandJson - The command JSON
-     * @param ClientSocket - The client socket
+     * Read everything available on a client socket and queue the complete messages (I/O thread)
+     * @param ClientConnection - The client connection to read from
+     * @param OutBytesRead - If set, receives the number of bytes read
+     * @return False if the peer closed the connection or it failed, and it should be cleaned up
      */
-    virtual void ProcessCommand(const FString& CommandJson, FSocket* ClientSocket);
+    virtual bool ReceiveClientData(FMCPClientConnection& ClientConnection, int32* OutBytesRead = nullptr);
     
     /**
-     * Check for client timeouts
-     * @param DeltaTime - Time since last tick
+     * Write the responses queued by SendResponse to their sockets (I/O thread)
+     */
+    virtual void ProcessPendingResponses();
+    
+    /**
+     * Write as much of a connection's outbound queue as the socket accepts (I/O thread)
+     * Unsent bytes stay queued and are resumed on a later call
+     * @param ClientConnection - The client connection to flush
+     * @return False if the connection failed and should be cleaned up
+     */
+    virtual bool FlushOutbound(FMCPClientConnection& ClientConnection);
+    
+    /**
+     * Resume writing on every connection with queued responses (I/O thread, polling fallback only)
+     */
+    virtual void FlushAllOutbound();
+    
+    /**
+     * Decode a received payload in whichever encoding it uses and queue it by its command's priority,
+     * behind whatever it must not overtake from the same connection (game thread)
+     * Payloads that cannot be decoded are answered with an error straight away
+     * @param Payload - The request payload
+     * @param Context - Where the command came from
+     */
+    virtual void ScheduleCommandPayload(const TArray<uint8>& Payload, const FMCPRequestContext& Context);
+    
+    /**
+     * Remove a command taken from the ready queues from its connection's backlog (game thread)
+     * @param Ready - The dequeued command
      */
-    virtual void CheckClientTimeouts(float DeltaTime);
+    void ReleaseBacklog(const FMCPReadyCommand& Ready);
+    
+    /**
+     * Release a request's place in the queue and its client's in-flight count once it has been answered
+     * @param Context - Where the request came from
+     */
+    void FinishRequest(const FMCPRequestContext& Context);
+    
+    /**
+     * Dispatch a decoded command to its handler and send the response (game thread)
+     * @param Command - The decoded command object
+     * @param Context - Where the command came from
+     * @return False if the request continues as a stream and is finished on a later tick
+     */
+    virtual bool DispatchCommand(const TSharedPtr<FJsonObject>& Command, const FMCPRequestContext& Context);
+    
+    /**
+     * Execute a command with a registered handler and send the response
+     * Runs on a worker thread for thread-safe handlers, otherwise on the game thread
+     * @param Entry - The command's dispatch table entry
+     * @param Command - The decoded command object
+     * @param Context - Where the command came from
+     * @return False if the request continues as a stream and is finished on a later tick (game thread only)
+     */
+    virtual bool ExecuteCommand(const FMCPDispatchTable::FEntry& Entry, const TSharedPtr<FJsonObject>& Command, const FMCPRequestContext& Context);
+    
+    /**
+     * Advance a streamed response by one step unless its client is behind on reading (game thread)
+     * @param Active - The stream
+     * @return True once the stream has finished or been abandoned
+     */
+    bool StepStream(FMCPActiveStream& Active);
+    
+    /**
+     * Run a thread-safe command on a worker thread, outside the frame budget (game thread)
+     * @param Table - The dispatch table holding the command's entry, kept alive until the command finishes
+     * @param Entry - The command's dispatch table entry
+     * @param Command - The decoded command object
+     * @param Context - Where the command came from
+     */
+    void LaunchWorkerCommand(TSharedRef<const FMCPDispatchTable> Table, const FMCPDispatchTable::FEntry& Entry, TSharedPtr<FJsonObject> Command, FMCPRequestContext Context);
+    
+    /**
+     * Refuse a request with a busy response (I/O thread)
+     * Extracts only the request's id, to address the response to it
+     * @param Payload - The refused request
+     * @param Context - Where the request came from
+     * @param Reason - Why it was refused
+     * @param RetryAfterSeconds - How long the client should wait before retrying
+     */
+    void RejectBusy(const TArray<uint8>& Payload, FMCPRequestContext Context, const FString& Reason, double RetryAfterSeconds);
+    
+    /**
+     * Wake the I/O thread, e.g. after queuing a response; safe to call from any thread
+     */
+    void WakeIOThread();
+    
+    /**
+     * Disconnect clients whose idle, request or write deadline has passed (I/O thread)
+     * Only connections whose timer is due are looked at
+     */
+    virtual void CheckClientTimeouts();
+    
+    /**
+     * Schedule a timer for a connection's earliest deadline if it has moved earlier (I/O thread)
+     * Deadlines that move later are picked up when the existing timer fires
+     * @param ClientConnection - The client connection
+     */
+    void UpdateConnectionDeadline(FMCPClientConnection& ClientConnection);
     
     /**
      * Clean up a client connection
@@ -217,7 +704,7 @@ protected:
     FString GetSafeSocketDescription(FSocket* Socket);
     
     /**
-     * Connection handler
+     * Connection handler (I/O thread)
      * @param InSocket - The new client socket
      * @param Endpoint - The client endpoint
      * @return True if connection accepted
@@ -227,11 +714,77 @@ protected:
     /** Server configuration */
     FMCPTCPServerConfig Config;
     
-    /** TCP listener */
-    FTcpListener* Listener;
+    /** Listening socket, accepted on by the I/O thread */
+    FSocket* ListenSocket;
+    
+    /** Optional Unix domain socket listener, accepted on by the I/O thread */
+    FSocket* UnixListenSocket;
     
-    /** Client connections */
-    TArray<FMCPClientConnection> ClientConnections;
+    /** Reassembly buffers lent to connections with partially received requests (I/O thread) */
+    FMCPBufferPool ReceiveBufferPool;
+    
+    /** Socket reads land here before being copied into a connection's framer (I/O thread) */
+    TArray<uint8> ReceiveScratch;
+    
+    /** Client connections, owned by the I/O thread while the server is running */
+    TMCPSlotMap<FMCPClientConnection> ClientConnections;
+    
+    /** Connection lookup for responses addressed by socket only (I/O thread) */
+    TMap<FSocket*, FMCPConnectionHandle> SocketConnections;
+    
+    /** Deadline timers for client connections (I/O thread) */
+    TMCPTimerWheel<FMCPConnectionHandle> ConnectionTimers;
+    
+    /** Requests framed by the I/O thread, drained by the game thread */
+    TQueue<FMCPPendingCommand, EQueueMode::Mpsc> PendingCommands;
+    
+    /** Decoded requests waiting to execute, by EMCPCommandPriority (game thread) */
+    TQueue<FMCPReadyCommand, EQueueMode::Spsc> ReadyCommands[int32(EMCPCommandPriority::Num)];
+    
+    /** What each connection has waiting in ReadyCommands; connections with nothing waiting have no entry (game thread) */
+    TMap<FMCPConnectionHandle, FMCPConnectionBacklog> ConnectionBacklogs;
+    
+    /** Number of commands received but not yet answered */
+    std::atomic<int32> PendingCommandCount;
+    
+    /** Responses of cacheable read-only commands */
+    FMCPResponseCache ResponseCache;
+    
+    /** Number of client connections, published by the I/O thread */
+    std::atomic<int32> NumConnections;
+    
+    /** Requests refused with a busy response */
+    std::atomic<int64> BusyResponseCount;
+    
+    /** Commands executing on worker threads, readable from any thread */
+    std::atomic<int32> NumWorkerCommands;
+    
+    /** Tasks running thread-safe commands, joined when the server stops (game thread) */
+    TArray<UE::Tasks::FTask> WorkerTasks;
+    
+    /** Streamed responses still being produced (game thread) */
+    TArray<FMCPActiveStream> ActiveStreams;
+    
+    /** Commands executed by the last game thread tick */
+    int32 LastTickCommandCount;
+    
+    /** Time spent executing commands in the last game thread tick */
+    double LastTickMilliseconds;
+    
+    /** Responses produced by any thread, drained by the I/O thread */
+    TQueue<FMCPPendingResponse, EQueueMode::Mpsc> PendingResponses;
+    
+    /** Runnable driving the I/O loop */
+    TUniquePtr<FMCPServerIOThread> IORunnable;
+    
+    /** Thread running the I/O loop */
+    FRunnableThread* IOThread;
+    
+    /** Socket readiness notification, lives as long as the server so any thread can wake it */
+    TUniquePtr<FMCPSocketPoller> Poller;
+    
+    /** Events from the last poller wait (I/O thread) */
+    TArray<FMCPSocketEvent> SocketEvents;
     
     /** Running flag */
     bool bRunning;
@@ -241,6 +794,20 @@ protected:
     
     /** Command handlers map */
     TMap<FString, TSharedPtr<IMCPCommandHandler>> CommandHandlers;
+    
+    /** Counters for every command ever registered, kept across re-registration */
+    TMap<FString, TSharedRef<FMCPCommandStats>> CommandStats;
+    
+    /** Shared memory channels opened by clients (game thread) */
+    TSharedRef<FMCPSharedChannelRegistry> SharedChannels;
+    
+    /** Lookup table built from CommandHandlers */
+    TSharedRef<const FMCPDispatchTable> DispatchTable;
+    
+    /**
+     * Rebuild DispatchTable after CommandHandlers changes
+     */
+    void RebuildDispatchTable();
 
 private:
     // Disable copy and assignment
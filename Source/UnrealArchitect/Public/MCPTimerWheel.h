@@ -0,0 +1,153 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "MCPConstants.h"
+
+/**
+ * Hierarchical timer wheel
+ * Timers are bucketed by deadline in four levels of 64 slots, each level 64 times coarser than
+ * the one below, and migrate down a level when their bucket comes round. Scheduling is O(1) and
+ * advancing costs O(ticks elapsed + timers expired), however many timers are pending.
+ * Timers cannot be cancelled; owners ignore firings they no longer care about and reschedule
+ * those whose deadline has moved later, which keeps frequent deadline updates free.
+ */
+template<typename KeyType>
+class TMCPTimerWheel
+{
+    static constexpr int32 NUM_LEVELS = 4;
+    static constexpr int32 SLOT_BITS = 6;
+    static constexpr int32 NUM_SLOTS = 1 << SLOT_BITS;
+    static constexpr uint64 SLOT_MASK = NUM_SLOTS - 1;
+
+    /** Furthest a timer can be scheduled ahead; later deadlines fire early and get rescheduled */
+    static constexpr uint64 MAX_TICKS_AHEAD = (uint64(1) << (SLOT_BITS * NUM_LEVELS)) - 1;
+
+    struct FTimer
+    {
+        KeyType Key;
+        double Deadline;
+        uint64 Tick;
+    };
+
+public:
+    /**
+     * Constructor
+     * @param InTickSeconds - Resolution of the wheel; timers fire up to one tick after their deadline
+     */
+    explicit TMCPTimerWheel(double InTickSeconds = MCPConstants::TIMER_WHEEL_TICK_SECONDS)
+        : TickSeconds(InTickSeconds)
+        , Origin(FPlatformTime::Seconds())
+    {
+    }
+
+    /**
+     * Schedule a timer
+     * @param Key - Passed back when the timer fires
+     * @param Deadline - When the timer fires, in FPlatformTime::Seconds
+     */
+    void Schedule(const KeyType& Key, double Deadline)
+    {
+        const double TicksFromOrigin = FMath::Max(FMath::CeilToDouble((Deadline - Origin) / TickSeconds), 0.0);
+        const uint64 Tick = FMath::Clamp(uint64(FMath::Min(TicksFromOrigin, double(MAX_uint64 / 2))), CurrentTick + 1, CurrentTick + MAX_TICKS_AHEAD);
+        Insert(FTimer{ Key, Deadline, Tick });
+        ++NumTimers;
+    }
+
+    /**
+     * Fire every timer whose deadline has passed
+     * @param Now - The current time, in FPlatformTime::Seconds
+     * @param OnExpired - Called as OnExpired(Key, Deadline) for each expired timer; may schedule new timers
+     */
+    template<typename FuncType>
+    void Advance(double Now, FuncType&& OnExpired)
+    {
+        const uint64 NowTick = uint64(FMath::Max((Now - Origin) / TickSeconds, 0.0));
+        if (NumTimers == 0)
+        {
+            CurrentTick = FMath::Max(CurrentTick, NowTick);
+            return;
+        }
+
+        while (CurrentTick < NowTick)
+        {
+            ++CurrentTick;
+
+            // Pull the coarser buckets that start at this tick down a level, coarsest first
+            int32 Level = 0;
+            while (Level + 1 < NUM_LEVELS && ((CurrentTick >> (SLOT_BITS * (Level + 1))) << (SLOT_BITS * (Level + 1))) == CurrentTick)
+            {
+                ++Level;
+            }
+            for (; Level > 0; --Level)
+            {
+                TArray<FTimer> Cascaded = MoveTemp(Wheel[Level][(CurrentTick >> (SLOT_BITS * Level)) & SLOT_MASK]);
+                for (const FTimer& Timer : Cascaded)
+                {
+                    Insert(Timer);
+                }
+            }
+
+            TArray<FTimer>& Bucket = Wheel[0][CurrentTick & SLOT_MASK];
+            if (Bucket.Num() > 0)
+            {
+                // Callbacks may schedule, which never lands in the bucket being fired
+                TArray<FTimer> Expired = MoveTemp(Bucket);
+                NumTimers -= Expired.Num();
+                for (const FTimer& Timer : Expired)
+                {
+                    OnExpired(Timer.Key, Timer.Deadline);
+                }
+            }
+
+            if (NumTimers == 0)
+            {
+                CurrentTick = NowTick;
+            }
+        }
+    }
+
+    /** @return Number of pending timers, including ones their owners no longer care about */
+    int32 Num() const { return NumTimers; }
+
+    /** Drop every pending timer */
+    void Empty()
+    {
+        for (int32 Level = 0; Level < NUM_LEVELS; ++Level)
+        {
+            for (int32 Slot = 0; Slot < NUM_SLOTS; ++Slot)
+            {
+                Wheel[Level][Slot].Empty();
+            }
+        }
+        NumTimers = 0;
+    }
+
+private:
+    void Insert(const FTimer& Timer)
+    {
+        // Timers due within 64 ticks go on the finest level, within 64^2 on the next, and so on
+        const uint64 Delta = Timer.Tick > CurrentTick ? Timer.Tick - CurrentTick : 0;
+        int32 Level = 0;
+        while (Level + 1 < NUM_LEVELS && Delta >= (uint64(1) << (SLOT_BITS * (Level + 1))))
+        {
+            ++Level;
+        }
+        Wheel[Level][(Timer.Tick >> (SLOT_BITS * Level)) & SLOT_MASK].Add(Timer);
+    }
+
+    /** Pending timers by level and slot */
+    TArray<FTimer> Wheel[NUM_LEVELS][NUM_SLOTS];
+
+    /** Seconds per tick */
+    double TickSeconds;
+
+    /** Time of tick zero */
+    double Origin;
+
+    /** Last tick that has been fired */
+    uint64 CurrentTick = 0;
+
+    /** Number of pending timers */
+    int32 NumTimers = 0;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPConstants.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * How a message payload is encoded
+ */
+enum class EMCPWireEncoding : uint8
+{
+    /** UTF-8 JSON text */
+    Json,
+
+    /** CBOR (RFC 8949) binary encoding of the same object model */
+    Cbor
+};
+
+/**
+ * Converts message payloads between their wire encoding and FJsonObject
+ * Binary encodings are decoded into the same object model as JSON, so command handlers
+ * never see which encoding a client used
+ */
+class UNREALARCHITECT_API FMCPWireCodec
+{
+public:
+    /**
+     * Determine the encoding of a received payload from its first byte
+     * JSON requests start with '{' or whitespace; CBOR requests start with a map header
+     * @param Payload - The received message
+     * @return The payload's encoding
+     */
+    static EMCPWireEncoding Detect(const TArray<uint8>& Payload);
+
+    /**
+     * Determine the encoding of a message from its first byte
+     * @param Data - The message bytes
+     * @param Num - Number of bytes
+     * @return The message's encoding
+     */
+    static EMCPWireEncoding Detect(const uint8* Data, int32 Num);
+
+    /**
+     * Decode a CBOR payload
+     * @param Payload - The received message
+     * @param OutObject - The decoded object
+     * @return True if the payload is a well-formed CBOR map
+     */
+    static bool DecodeCbor(const TArray<uint8>& Payload, TSharedPtr<FJsonObject>& OutObject);
+
+    /**
+     * Decode a CBOR payload in place, e.g. straight from shared memory
+     * @param Data - The encoded bytes
+     * @param Num - Number of encoded bytes
+     * @param OutObject - The decoded object
+     * @return True if the bytes are a well-formed CBOR map
+     */
+    static bool DecodeCbor(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject);
+
+    /**
+     * Decode UTF-8 JSON text in place, without first widening it into an FString
+     * @param Data - The UTF-8 bytes
+     * @param Num - Number of bytes
+     * @param OutObject - The decoded object
+     * @param IndexThreshold - Texts at least this large get a SIMD structural index built first
+     * @return True if the bytes are a single well-formed JSON object
+     */
+    static bool DecodeJson(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject,
+        int32 IndexThreshold = MCPConstants::JSON_STRUCTURAL_INDEX_THRESHOLD);
+
+    /**
+     * Extract one string, number or literal member of a payload's top-level object
+     * Every other member is stepped over without being decoded, so this stays cheap on large requests
+     * @param Data - The encoded bytes
+     * @param Num - Number of encoded bytes
+     * @param Name - The member's key
+     * @return The member's value, or null if it is missing, a container, or the payload is malformed up to it
+     */
+    static TSharedPtr<FJsonValue> FindScalarMember(const uint8* Data, int32 Num, const TCHAR* Name);
+
+    /**
+     * Decode a payload in whichever encoding it uses
+     * @param Data - The encoded bytes
+     * @param Num - Number of encoded bytes
+     * @param OutObject - The decoded object
+     * @return True if the bytes are a well-formed JSON object or CBOR map
+     */
+    static bool Decode(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject);
+
+    /**
+     * Encode an object as condensed UTF-8 JSON text on a single line
+     * @param Object - The object to encode
+     * @param OutPayload - Receives the encoded bytes
+     */
+    static void EncodeJson(const TSharedRef<FJsonObject>& Object, TArray<uint8>& OutPayload);
+
+    /**
+     * Encode an object as CBOR
+     * @param Object - The object to encode
+     * @param OutPayload - Receives the encoded bytes
+     */
+    static void EncodeCbor(const TSharedRef<FJsonObject>& Object, TArray<uint8>& OutPayload);
+
+    /**
+     * Look up an encoding by the name clients use in the negotiate_encoding command
+     * @param Name - The encoding name, e.g. "json" or "cbor"
+     * @param OutEncoding - The matching encoding
+     * @return True if the name is a supported encoding
+     */
+    static bool FromName(const FString& Name, EMCPWireEncoding& OutEncoding);
+
+    /**
+     * Get the name of an encoding
+     * @param Encoding - The encoding
+     * @return The encoding's name
+     */
+    static const TCHAR* ToName(EMCPWireEncoding Encoding);
+};
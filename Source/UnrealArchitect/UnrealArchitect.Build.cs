@@ -1,5 +1,6 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
+using System.IO;
 using UnrealBuildTool;
 
 public class UnrealArchitect : ModuleRules
@@ -40,6 +41,20 @@ public class UnrealArchitect : ModuleRules
 		);
 		
 		
+		if (Target.Platform == UnrealTargetPlatform.Linux)
+		{
+			// epoll needs the native descriptors behind FSocket, which are only exposed by the BSD socket implementation
+			PrivateIncludePaths.Add(Path.Combine(EngineDirectory, "Source", "Runtime", "Sockets", "Private"));
+			PrivateDefinitions.Add("MCP_WITH_EPOLL=1");
+			PrivateDefinitions.Add("MCP_WITH_UNIX_SOCKETS=1");
+		}
+		else
+		{
+			PrivateDefinitions.Add("MCP_WITH_EPOLL=0");
+			PrivateDefinitions.Add("MCP_WITH_UNIX_SOCKETS=0");
+		}
+		
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{